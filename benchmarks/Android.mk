@@ -0,0 +1,59 @@
+# Copyright (C) 2010 The Android Open Source Project
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Benchmarks are built as optimized executables. They print their
+# timings on stdout.
+
+LOCAL_PATH := $(call my-dir)
+
+libastl_bench_includes:= \
+	bionic/libstdc++/include \
+	external/astl/include
+libastl_bench_static_lib := libastl
+libastl_bench_host_static_lib := libastl_host
+
+# $(1): source list
+# $(2): "HOST_" or empty
+# $(3): "_host" or empty
+define _define-bench
+$(foreach file,$(1), \
+  $(eval include $(CLEAR_VARS)) \
+  $(eval LOCAL_SRC_FILES := $(file)) \
+  $(eval LOCAL_C_INCLUDES := $(libastl_bench_includes)) \
+  $(eval LOCAL_MODULE := $(notdir $(file:%.cpp=%))$(3)) \
+  $(eval LOCAL_CFLAGS += -O2) \
+  $(eval LOCAL_STATIC_LIBRARIES := $(libastl_bench$(3)_static_lib)) \
+  $(eval LOCAL_MODULE_TAGS := eng) \
+  $(eval LOCAL_LDLIBS := $(if $(2),-lpthread)) \
+  $(eval $(if $(2),,LOCAL_MODULE_PATH := $(TARGET_OUT_DATA_APPS))) \
+  $(eval include $(BUILD_$(2)EXECUTABLE)) \
+)
+endef
+
+sources := \
+   bench_algorithm.cpp \
+   bench_hash.cpp \
+   bench_ostream.cpp \
+   bench_parallel.cpp \
+   bench_queue.cpp \
+   bench_sort.cpp \
+   bench_string.cpp \
+   bench_vector.cpp
+
+ifeq ($(HOST_OS),linux)
+$(call _define-bench,$(sources),HOST_,_host)
+endif
+
+$(call _define-bench,$(sources))
@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+
+#include "../include/algorithm"
+#ifndef ANDROID_ASTL_ALGORITHM__
+#error "Wrong header included!!"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../include/eytzinger.h"
+#include "../include/vector"
+#include "benchmark.h"
+
+namespace {
+
+// Process kTotal bytes per measurement.
+const size_t kTotal = 1024 * 1024 * 1024;
+
+// Element by element references.
+template<typename _T>
+bool naiveEqual(const _T *begin1, const _T *end1, const _T *begin2) {
+    for (; begin1 != end1; ++begin1, ++begin2) {
+        if (!(*begin1 == *begin2)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename _T>
+bool naiveLess(const _T *begin1, const _T *end1,
+               const _T *begin2, const _T *end2) {
+    for (; begin1 != end1 && begin2 != end2; ++begin1, ++begin2) {
+        if (*begin1 < *begin2) return true;
+        if (*begin2 < *begin1) return false;
+    }
+    return begin1 == end1 && begin2 != end2;
+}
+
+void reportThroughput(const char *name, size_t bytes, const Timer& timer) {
+    const long long us = timer.elapsedUs();
+    char label[64];
+    char comment[64];
+    if (bytes < 1024) {
+        std::snprintf(label, sizeof(label), "%s %uB", name,
+                      static_cast<unsigned>(bytes));
+    } else if (bytes < 1024 * 1024) {
+        std::snprintf(label, sizeof(label), "%s %uKB", name,
+                      static_cast<unsigned>(bytes / 1024));
+    } else {
+        std::snprintf(label, sizeof(label), "%s %uMB", name,
+                      static_cast<unsigned>(bytes / (1024 * 1024)));
+    }
+    std::snprintf(comment, sizeof(comment), "(%lld MB/s)",
+                  us > 0 ? static_cast<long long>(kTotal) / us : 0LL);
+    report(label, timer, comment);
+}
+
+// Compare two equal buffers of bytes: the whole range is scanned.
+template<typename _T>
+void benchCompare(const char *type, size_t bytes) {
+    const size_t n = bytes / sizeof(_T);
+    _T *a = static_cast<_T*>(malloc(bytes));
+    _T *b = static_cast<_T*>(malloc(bytes));
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = b[i] = static_cast<_T>(i * 7);
+    }
+    const size_t rounds = kTotal / bytes;
+    char name[64];
+    size_t count = 0;
+
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            count += naiveEqual(a, a + n, b);
+            doNotOptimize(a[0]);
+        }
+        std::snprintf(name, sizeof(name), "naive equal %s", type);
+        reportThroughput(name, bytes, timer);
+    }
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            count += std::equal(a, a + n, b);
+            doNotOptimize(a[0]);
+        }
+        std::snprintf(name, sizeof(name), "equal %s", type);
+        reportThroughput(name, bytes, timer);
+    }
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            count += std::mismatch(a, a + n, b).first == a + n;
+            doNotOptimize(a[0]);
+        }
+        std::snprintf(name, sizeof(name), "mismatch %s", type);
+        reportThroughput(name, bytes, timer);
+    }
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            count += naiveLess(a, a + n, b, b + n);
+            doNotOptimize(a[0]);
+        }
+        std::snprintf(name, sizeof(name), "naive lexicographical %s", type);
+        reportThroughput(name, bytes, timer);
+    }
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            count += std::lexicographical_compare(a, a + n, b, b + n);
+            doNotOptimize(a[0]);
+        }
+        std::snprintf(name, sizeof(name), "lexicographical %s", type);
+        reportThroughput(name, bytes, timer);
+    }
+    doNotOptimize(count);
+    free(a);
+    free(b);
+}
+
+template<typename _T>
+const _T *naiveFind(const _T *first, const _T *last, _T value) {
+    while (first != last && !(*first == value)) {
+        ++first;
+    }
+    return first;
+}
+
+// Search a value stored at the end of the buffer and count its
+// occurrences: the whole range is scanned.
+template<typename _T>
+void benchFind(const char *type, size_t bytes) {
+    const size_t n = bytes / sizeof(_T);
+    _T *data = static_cast<_T*>(malloc(bytes));
+    for (size_t i = 0; i < n; ++i) {
+        data[i] = static_cast<_T>(i % 100);
+    }
+    const _T value = static_cast<_T>(101);
+    data[n - 1] = value;
+    const size_t rounds = kTotal / bytes;
+    char name[64];
+    size_t sum = 0;
+
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            sum += naiveFind(data, data + n, value) - data;
+            doNotOptimize(data[0]);
+        }
+        std::snprintf(name, sizeof(name), "naive find %s", type);
+        reportThroughput(name, bytes, timer);
+    }
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            sum += std::find(data, data + n, value) - data;
+            doNotOptimize(data[0]);
+        }
+        std::snprintf(name, sizeof(name), "find %s", type);
+        reportThroughput(name, bytes, timer);
+    }
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            sum += std::count(data, data + n, value);
+            doNotOptimize(data[0]);
+        }
+        std::snprintf(name, sizeof(name), "count %s", type);
+        reportThroughput(name, bytes, timer);
+    }
+    {
+        // A pattern whose first element is frequent.
+        const _T pattern[] = {0, 1, 2, 3, 4, 5, 6, 101};
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            sum += std::search(data, data + n, pattern, pattern + 8) - data;
+            doNotOptimize(data[0]);
+        }
+        std::snprintf(name, sizeof(name), "search %s", type);
+        reportThroughput(name, bytes, timer);
+    }
+    doNotOptimize(sum);
+    free(data);
+}
+
+// Look up random keys in a sorted table of n ints.
+void benchBinarySearch(size_t n) {
+    const size_t kLookups = 10 * 1000 * 1000;
+    int *sorted = static_cast<int*>(malloc(n * sizeof(int)));
+    int *tree = static_cast<int*>(malloc((n + 1) * sizeof(int)));
+    int *keys = static_cast<int*>(malloc(kLookups * sizeof(int)));
+    for (size_t i = 0; i < n; ++i) {
+        sorted[i] = static_cast<int>(2 * i);
+    }
+    android::eytzinger_layout(sorted, n, tree);
+    unsigned int seed = 1;
+    for (size_t i = 0; i < kLookups; ++i) {
+        seed = seed * 1103515245 + 12345;
+        keys[i] = static_cast<int>((seed >> 1) % (2 * n));
+    }
+    char label[64];
+    size_t sum = 0;
+    {
+        Timer timer;
+        for (size_t i = 0; i < kLookups; ++i) {
+            sum += std::__lower_bound(sorted, sorted + n, keys[i],
+                                      std::__less()) - sorted;
+        }
+        std::snprintf(label, sizeof(label), "branchy lower_bound %u",
+                      static_cast<unsigned>(n));
+        report(label, timer);
+    }
+    {
+        Timer timer;
+        for (size_t i = 0; i < kLookups; ++i) {
+            sum += std::lower_bound(sorted, sorted + n, keys[i]) - sorted;
+        }
+        std::snprintf(label, sizeof(label), "lower_bound %u",
+                      static_cast<unsigned>(n));
+        report(label, timer);
+    }
+    {
+        Timer timer;
+        for (size_t i = 0; i < kLookups; ++i) {
+            sum += android::eytzinger_lower_bound(tree, n, keys[i]);
+        }
+        std::snprintf(label, sizeof(label), "eytzinger_lower_bound %u",
+                      static_cast<unsigned>(n));
+        report(label, timer);
+    }
+    doNotOptimize(sum);
+    free(sorted);
+    free(tree);
+    free(keys);
+}
+
+// 16 byte value filled by the 128 bit kernel.
+struct Quad {
+    int a, b, c, d;
+};
+
+// The loop std::fill used for these types.
+template<typename _T>
+void naiveFill(_T *begin, _T *end, const _T& value) {
+    const _T tmp = value;
+    for (; begin < end; ++begin) {
+        *begin = tmp;
+    }
+}
+
+template<typename _T>
+void benchFill(const char *type, size_t bytes, const _T& value) {
+    const size_t n = bytes / sizeof(_T);
+    _T *a = static_cast<_T*>(malloc(bytes));
+    memset(a, 1, bytes);  // Fault the pages in.
+    const size_t rounds = kTotal / bytes;
+    char name[64];
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            naiveFill(a, a + n, value);
+            doNotOptimize(a[0]);
+        }
+        std::snprintf(name, sizeof(name), "naive fill %s", type);
+        reportThroughput(name, bytes, timer);
+    }
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            std::fill(a, a + n, value);
+            doNotOptimize(a[0]);
+        }
+        std::snprintf(name, sizeof(name), "fill %s", type);
+        reportThroughput(name, bytes, timer);
+    }
+    free(a);
+}
+
+// vector<char> iterators are unwrapped to reach memset.
+void benchFillIterators(size_t bytes) {
+    std::vector<char> chars(bytes, 1);
+    const size_t rounds = kTotal / bytes;
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            for (std::vector<char>::iterator it = chars.begin();
+                 it != chars.end(); ++it) {
+                *it = static_cast<char>(r);
+            }
+            doNotOptimize(chars[0]);
+        }
+        reportThroughput("naive fill vector<char>", bytes, timer);
+    }
+    {
+        Timer timer;
+        for (size_t r = 0; r < rounds; ++r) {
+            std::fill(chars.begin(), chars.end(), static_cast<char>(r));
+            doNotOptimize(chars[0]);
+        }
+        reportThroughput("fill vector<char>", bytes, timer);
+    }
+}
+
+}  // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    const size_t sizes[] = {4 * 1024, 64 * 1024, 1024 * 1024};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        benchCompare<unsigned char>("uchar", sizes[i]);
+        benchCompare<int>("int", sizes[i]);
+    }
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        benchFind<char>("char", sizes[i]);
+        benchFind<int>("int", sizes[i]);
+        benchFind<long long>("int64", sizes[i]);
+    }
+    const Quad quad = {1, 2, 3, 4};
+    for (size_t bytes = 64; bytes <= 64 * 1024 * 1024; bytes *= 16) {
+        benchFill<short>("short", bytes, 7);
+        benchFill<int>("int", bytes, 7);
+        benchFill<double>("double", bytes, 0.5);
+        benchFill<Quad>("quad", bytes, quad);
+        benchFillIterators(bytes);
+    }
+    const size_t tables[] = {1000, 100 * 1000, 10 * 1000 * 1000};
+    for (size_t i = 0; i < sizeof(tables) / sizeof(tables[0]); ++i) {
+        benchBinarySearch(tables[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "../include/functional"
+#ifndef ANDROID_ASTL_FUNCTIONAL__
+#error "Wrong header included!!"
+#endif
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "benchmark.h"
+
+namespace {
+
+// Reference: one byte per step, each depending on the previous one.
+size_t naiveHash(const void *data, size_t len) {
+    const unsigned char *p = static_cast<const unsigned char*>(data);
+    size_t h = 0;
+    for (size_t i = 0; i < len; ++i) {
+        h = h * 31 + p[i];
+    }
+    return h;
+}
+
+// Hash kTotal bytes using keys of length len.
+const size_t kTotal = 256 * 1024 * 1024;
+
+template<typename _Hash>
+void benchHash(const char *name, _Hash hash, const char *buffer, size_t len) {
+    const size_t iterations = kTotal / len;
+    size_t sum = 0;
+    Timer timer;
+    for (size_t i = 0; i < iterations; ++i) {
+        // Vary the start so consecutive keys differ.
+        sum += hash(buffer + (i & 63), len);
+    }
+    doNotOptimize(sum);
+    const long long us = timer.elapsedUs();
+    char label[64];
+    char comment[64];
+    std::snprintf(label, sizeof(label), "%s %u bytes", name,
+                  static_cast<unsigned>(len));
+    std::snprintf(comment, sizeof(comment), "(%lld MB/s)",
+                  us > 0 ? static_cast<long long>(kTotal) / us : 0LL);
+    report(label, timer, comment);
+}
+
+void benchStringHash(size_t len) {
+    const std::string key(len, 'x');
+    const std::hash<std::string> hash;
+    const size_t iterations = kTotal / len;
+    size_t sum = 0;
+    Timer timer;
+    for (size_t i = 0; i < iterations; ++i) {
+        sum += hash(key);
+    }
+    doNotOptimize(sum);
+    char label[64];
+    std::snprintf(label, sizeof(label), "hash<string> %u bytes",
+                  static_cast<unsigned>(len));
+    report(label, timer);
+}
+
+}  // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    static char buffer[4096 + 64];
+    for (size_t i = 0; i < sizeof(buffer); ++i) {
+        buffer[i] = static_cast<char>(i * 131);
+    }
+    const size_t lengths[] = {4, 8, 16, 32, 64, 256, 1024, 4096};
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i) {
+        benchHash("naive", naiveHash, buffer, lengths[i]);
+        benchHash("hash_bytes", android::hash_bytes, buffer, lengths[i]);
+        benchStringHash(lengths[i]);
+    }
+    return 0;
+}
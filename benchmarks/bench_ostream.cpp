@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include "../include/stdio_filebuf.h"
+#ifndef ANDROID_ASTL_STDIO_FILEBUF__
+#error "Wrong header included!!"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <ostream>
+#include <sstream>
+#include "../include/fd_filebuf.h"
+#include "benchmark.h"
+
+// Write small tokens to /dev/null through an ostream.
+
+namespace {
+
+void reportTokens(const char *name, size_t tokens, const Timer& timer) {
+    const long long us = timer.elapsedUs();
+    char comment[64];
+    std::snprintf(comment, sizeof(comment), "(%.2f ns/token)",
+                  us * 1000.0 / tokens);
+    report(name, timer, comment);
+}
+
+void benchTokens(size_t tokens) {
+    FILE *null = fopen("/dev/null", "w");
+    if (null == NULL) {
+        std::printf("cannot open /dev/null\n");
+        return;
+    }
+    {
+        // What stdio_filebuf::xsputn used to do.
+        Timer timer;
+        for (size_t i = 0; i < tokens; ++i) {
+            fprintf(null, "%.*s", 4, "tok ");
+        }
+        fflush(null);
+        reportTokens("fprintf per token", tokens, timer);
+    }
+    {
+        android::stdio_filebuf buf(null, false);
+        std::ostream os(&buf);
+        Timer timer;
+        for (size_t i = 0; i < tokens; ++i) {
+            os << "tok ";
+        }
+        os.flush();
+        reportTokens("unbuffered ostream", tokens, timer);
+    }
+    {
+        android::stdio_filebuf buf(null);
+        std::ostream os(&buf);
+        Timer timer;
+        for (size_t i = 0; i < tokens; ++i) {
+            os << "tok ";
+        }
+        os.flush();
+        reportTokens("buffered ostream", tokens, timer);
+    }
+    {
+        android::stdio_filebuf buf(null);
+        std::ostream os(&buf);
+        Timer timer;
+        for (size_t i = 0; i < tokens; ++i) {
+            os << 'x';
+        }
+        os.flush();
+        reportTokens("buffered ostream char", tokens, timer);
+    }
+    fclose(null);
+    {
+        std::stringstream ss;
+        Timer timer;
+        for (size_t i = 0; i < tokens; ++i) {
+            ss << 'x';
+            if ((i & 0xffff) == 0xffff) {
+                ss.str("");
+            }
+        }
+        reportTokens("stringstream char", tokens, timer);
+    }
+
+    const size_t sizes[] = {4096, android::fd_filebuf::kDefaultBufferSize};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        android::fd_ofstream os("/dev/null", false, sizes[i]);
+        Timer timer;
+        for (size_t t = 0; t < tokens; ++t) {
+            os << "tok ";
+        }
+        os.flush();
+        char name[64];
+        std::snprintf(name, sizeof(name), "fd_ofstream %uKB buffer",
+                      static_cast<unsigned>(sizes[i] / 1024));
+        reportTokens(name, tokens, timer);
+    }
+}
+
+// Format integers of all sizes, in decimal and hexadecimal.
+void benchIntegers(size_t count) {
+    FILE *null = fopen("/dev/null", "w");
+    if (null == NULL) {
+        std::printf("cannot open /dev/null\n");
+        return;
+    }
+    android::stdio_filebuf buf(null);
+    std::ostream os(&buf);
+    const char *fmts[] = {"%d", "%x"};
+    const std::ios_base::fmtflags bases[] = {std::ios_base::dec,
+                                             std::ios_base::hex};
+    for (size_t b = 0; b < 2; ++b) {
+        {
+            // What ostream::operator<<(int) used to do.
+            Timer timer;
+            unsigned val = 1;
+            for (size_t i = 0; i < count; ++i) {
+                char num[26];
+                const int len = snprintf(num, sizeof(num), fmts[b],
+                                         static_cast<int>(val));
+                os.write(num, len);
+                val = val * 1103515245 + 12345;
+            }
+            os.flush();
+            char name[64];
+            std::snprintf(name, sizeof(name), "snprintf(\"%s\")", fmts[b]);
+            reportTokens(name, count, timer);
+        }
+        {
+            os.setf(bases[b], std::ios_base::basefield);
+            Timer timer;
+            unsigned val = 1;
+            for (size_t i = 0; i < count; ++i) {
+                os << static_cast<int>(val);
+                val = val * 1103515245 + 12345;
+            }
+            os.flush();
+            reportTokens(b == 0 ? "ostream << int" : "ostream << hex int",
+                         count, timer);
+        }
+    }
+    {
+        os.setf(std::ios_base::dec, std::ios_base::basefield);
+        Timer timer;
+        for (size_t i = 0; i < count; ++i) {
+            os << i % 100;
+        }
+        os.flush();
+        reportTokens("ostream << small size_t", count, timer);
+    }
+    fclose(null);
+}
+
+// Format doubles at precision 6 and 17 and floats at precision 9,
+// which is enough to read them back.
+void benchFloats(size_t count) {
+    FILE *null = fopen("/dev/null", "w");
+    if (null == NULL) {
+        std::printf("cannot open /dev/null\n");
+        return;
+    }
+    android::stdio_filebuf buf(null);
+    std::ostream os(&buf);
+    const int precisions[] = {6, 17};
+    for (size_t p = 0; p < 2; ++p) {
+        {
+            // What ostream::operator<<(double) used to do, with %g.
+            Timer timer;
+            unsigned val = 1;
+            for (size_t i = 0; i < count; ++i) {
+                char num[32];
+                const int len = snprintf(num, sizeof(num), "%.*g",
+                                         precisions[p], val / 1000.0);
+                os.write(num, len);
+                val = val * 1103515245 + 12345;
+            }
+            os.flush();
+            char name[64];
+            std::snprintf(name, sizeof(name), "snprintf(\"%%.%dg\")",
+                          precisions[p]);
+            reportTokens(name, count, timer);
+        }
+        {
+            os.precision(precisions[p]);
+            Timer timer;
+            unsigned val = 1;
+            for (size_t i = 0; i < count; ++i) {
+                os << val / 1000.0;
+                val = val * 1103515245 + 12345;
+            }
+            os.flush();
+            char name[64];
+            std::snprintf(name, sizeof(name), "ostream << double, precision %d",
+                          precisions[p]);
+            reportTokens(name, count, timer);
+        }
+    }
+    {
+        Timer timer;
+        unsigned val = 1;
+        for (size_t i = 0; i < count; ++i) {
+            char num[32];
+            const int len = snprintf(num, sizeof(num), "%.9g",
+                                     static_cast<float>(val) / 1000);
+            os.write(num, len);
+            val = val * 1103515245 + 12345;
+        }
+        os.flush();
+        reportTokens("snprintf(\"%.9g\") float", count, timer);
+    }
+    {
+        os.precision(9);
+        Timer timer;
+        unsigned val = 1;
+        for (size_t i = 0; i < count; ++i) {
+            os << static_cast<float>(val) / 1000;
+            val = val * 1103515245 + 12345;
+        }
+        os.flush();
+        reportTokens("ostream << float, precision 9", count, timer);
+    }
+    fclose(null);
+}
+
+}  // anonymous namespace
+
+// @param argv[1] Number of tokens, 100M by default.
+int main(int argc, char **argv)
+{
+    const size_t tokens = argc > 1 ? strtoul(argv[1], NULL, 10) :
+            100 * 1000 * 1000;
+    benchTokens(tokens);
+    benchIntegers(tokens / 4);
+    benchFloats(tokens / 20);
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+#include "../include/parallel.h"
+#ifndef ANDROID_ASTL_PARALLEL_H__
+#error "Wrong header included!!"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "benchmark.h"
+
+// Time the android::par algorithms with 1, 2, 4 and 8 threads. The
+// speedup is relative to the single thread run, which is the
+// sequential algorithm.
+
+namespace {
+
+const size_t kThreads[] = {1, 2, 4, 8};
+
+struct Scale {
+    unsigned int operator()(unsigned int x) const { return x * 3 + 1; }
+};
+
+// Enough work per element to be compute bound.
+struct Hash {
+    void operator()(unsigned int& x) const {
+        for (int i = 0; i < 16; ++i) {
+            x = x * 2654435761u + (x >> 13);
+        }
+    }
+};
+
+void fillRandom(unsigned int *data, size_t n) {
+    unsigned int state = 42;
+    for (size_t i = 0; i < n; ++i) {
+        state = state * 1103515245u + 12345u;
+        data[i] = state ^ (state >> 16);
+    }
+}
+
+// Print the time taken with the current thread count and the speedup
+// over base_us (0 for the single thread run).
+long long reportRun(const char *name, size_t threads, const Timer& timer,
+                    long long base_us) {
+    const long long us = timer.elapsedUs();
+    char label[64];
+    char comment[64];
+    std::snprintf(label, sizeof(label), "%s %u threads", name,
+                  static_cast<unsigned>(threads));
+    std::snprintf(comment, sizeof(comment), "(x%.2f)",
+                  base_us == 0 || us == 0 ? 1.0 :
+                  static_cast<double>(base_us) / us);
+    std::printf("%-40s %10lld us %s\n", label, us, comment);
+    return us;
+}
+
+void benchAll(size_t n, size_t sort_n) {
+    unsigned int *src = static_cast<unsigned int*>(malloc(n * sizeof(*src)));
+    unsigned int *dst = static_cast<unsigned int*>(malloc(n * sizeof(*dst)));
+    if (src == NULL || dst == NULL) {
+        std::printf("%u elements: out of memory\n", static_cast<unsigned>(n));
+        free(src);
+        free(dst);
+        return;
+    }
+    fillRandom(src, n);
+    memset(dst, 0xff, n * sizeof(*dst));  // Fault the pages in.
+    long long base[6] = {0};
+    for (size_t t = 0; t < sizeof(kThreads) / sizeof(kThreads[0]); ++t) {
+        const size_t threads = kThreads[t];
+        android::par::set_thread_count(threads);
+        const long long *b = threads == 1 ? NULL : base;
+        long long us[6];
+        {
+            Timer timer;
+            android::par::fill(dst, dst + n, 7u);
+            us[0] = reportRun("fill", threads, timer, b ? b[0] : 0);
+        }
+        {
+            Timer timer;
+            android::par::copy(src, src + n, dst);
+            us[1] = reportRun("copy", threads, timer, b ? b[1] : 0);
+        }
+        {
+            Timer timer;
+            android::par::transform(src, src + n, dst, Scale());
+            us[2] = reportRun("transform", threads, timer, b ? b[2] : 0);
+        }
+        {
+            Timer timer;
+            android::par::for_each(dst, dst + n, Hash());
+            us[3] = reportRun("for_each", threads, timer, b ? b[3] : 0);
+        }
+        {
+            Timer timer;
+            doNotOptimize(android::par::reduce(src, src + n, 0u));
+            us[4] = reportRun("reduce", threads, timer, b ? b[4] : 0);
+        }
+        {
+            memcpy(dst, src, sort_n * sizeof(*dst));
+            Timer timer;
+            android::par::sort(dst, dst + sort_n);
+            us[5] = reportRun("sort", threads, timer, b ? b[5] : 0);
+        }
+        doNotOptimize(dst[n / 2]);
+        if (threads == 1) {
+            memcpy(base, us, sizeof(base));
+        }
+    }
+    free(src);
+    free(dst);
+}
+
+}  // anonymous namespace
+
+// @param argv[1] Number of elements, 64M by default (10M for sort).
+int main(int argc, char **argv)
+{
+    const size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) :
+            64 * 1024 * 1024;
+    benchAll(n, n < 10 * 1000 * 1000 ? n : 10 * 1000 * 1000);
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+
+#include "../include/queue"
+#ifndef ANDROID_ASTL_QUEUE__
+#error "Wrong header included!!"
+#endif
+#include <cstdio>
+#include <dary_heap.h>
+#include "benchmark.h"
+
+namespace {
+
+const int kOperations = 10 * 1000 * 1000;
+
+unsigned int nextRandom(unsigned int& seed) {
+    seed = seed * 1103515245 + 12345;
+    return seed >> 1;
+}
+
+// 10M pushes then 10M pops.
+template<typename _Queue>
+void benchFillDrain(const char *name) {
+    _Queue queue;
+    unsigned int seed = 1;
+    unsigned int sum = 0;
+    Timer timer;
+    for (int i = 0; i < kOperations; ++i) {
+        queue.push(nextRandom(seed));
+    }
+    while (!queue.empty()) {
+        sum += queue.top();
+        queue.pop();
+    }
+    doNotOptimize(sum);
+    report(name, timer);
+}
+
+// Scheduler like load: 10M push/pop pairs on a queue of size elements.
+template<typename _Queue>
+void benchSteady(const char *name, int size) {
+    _Queue queue;
+    unsigned int seed = 1;
+    for (int i = 0; i < size; ++i) {
+        queue.push(nextRandom(seed));
+    }
+    unsigned int sum = 0;
+    Timer timer;
+    for (int i = 0; i < kOperations; ++i) {
+        sum += queue.top();
+        queue.pop();
+        queue.push(nextRandom(seed));
+    }
+    doNotOptimize(sum);
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s %d", name, size);
+    report(label, timer);
+}
+
+}  // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    typedef std::priority_queue<unsigned int> binary_queue;
+    typedef android::dary_priority_queue<unsigned int, 4> dary_queue;
+
+    benchFillDrain<binary_queue>("priority_queue 10M push+pop");
+    benchFillDrain<dary_queue>("dary_priority_queue 10M push+pop");
+    const int sizes[] = {1000, 1000 * 1000};
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i) {
+        benchSteady<binary_queue>("priority_queue steady", sizes[i]);
+        benchSteady<dary_queue>("dary_priority_queue steady", sizes[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+
+#include "../include/radix_sort.h"
+#ifndef ANDROID_ASTL_RADIX_SORT_H__
+#error "Wrong header included!!"
+#endif
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "benchmark.h"
+
+namespace {
+
+// Sort about kMinTotal elements per measurement: small arrays are
+// sorted repeatedly.
+const size_t kMinTotal = 10 * 1000 * 1000;
+
+template<typename _T>
+void fillRandom(_T *data, size_t n) {
+    unsigned long long state = 42;
+    for (size_t i = 0; i < n; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        data[i] = static_cast<_T>(state ^ (state >> 29));
+    }
+}
+
+template<typename _T>
+void benchSort(const char *type, size_t n) {
+    _T *original = static_cast<_T*>(malloc(n * sizeof(_T)));
+    _T *data = static_cast<_T*>(malloc(n * sizeof(_T)));
+    if (original == NULL || data == NULL) {
+        std::printf("%s %u: out of memory\n", type, static_cast<unsigned>(n));
+        free(original);
+        free(data);
+        return;
+    }
+    fillRandom(original, n);
+    const size_t rounds = n < kMinTotal ? kMinTotal / n : 1;
+    char label[64];
+    char comment[64];
+
+    for (int radix = 0; radix < 2; ++radix) {
+        long long us = 0;
+        for (size_t r = 0; r < rounds; ++r) {
+            memcpy(data, original, n * sizeof(_T));
+            Timer timer;
+            if (radix) {
+                android::radix_sort(data, data + n);
+            } else {
+                std::sort(data, data + n);
+            }
+            us += timer.elapsedUs();
+            doNotOptimize(data[n / 2]);
+        }
+        std::snprintf(label, sizeof(label), "%s %s %u", type,
+                      radix ? "radix_sort" : "sort", static_cast<unsigned>(n));
+        std::snprintf(comment, sizeof(comment), "(%.2f ns/element)",
+                      us * 1000.0 / (static_cast<double>(n) * rounds));
+        std::printf("%-40s %10lld us %s\n", label, us, comment);
+    }
+    free(original);
+    free(data);
+}
+
+}  // anonymous namespace
+
+// @param argv[1] Largest array size, 10M by default.
+int main(int argc, char **argv)
+{
+    const size_t max_size = argc > 1 ? strtoul(argv[1], NULL, 10) :
+            10 * 1000 * 1000;
+    for (size_t n = 1000; n <= max_size; n *= 10) {
+        benchSort<unsigned int>("uint32", n);
+        benchSort<long long>("int64", n);
+    }
+    return 0;
+}
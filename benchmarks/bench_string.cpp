@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "../include/string"
+#ifndef ANDROID_ASTL_STRING__
+#error "Wrong header included!!"
+#endif
+#include <cstdio>
+#include "benchmark.h"
+
+namespace {
+using std::string;
+const size_t kNumChars = 1000000;
+
+void benchPushBack() {
+    Timer timer;
+    string str;
+    size_t reallocs = 0;
+    for (size_t i = 0; i < kNumChars; ++i) {
+        const size_t capacity = str.capacity();
+        str.push_back('a' + i % 26);
+        reallocs += capacity != str.capacity();
+    }
+    doNotOptimize(str);
+    char comment[64];
+    std::snprintf(comment, sizeof(comment), "(%u reallocs)",
+                  static_cast<unsigned>(reallocs));
+    report("push_back 1M chars", timer, comment);
+}
+
+void benchAppendOperator() {
+    Timer timer;
+    string str;
+    for (size_t i = 0; i < kNumChars / 4; ++i) {
+        str += "abcd";
+    }
+    doNotOptimize(str);
+    report("+= 1M chars (4 chars at a time)", timer);
+}
+
+void benchAppendReserved() {
+    Timer timer;
+    string str;
+    str.reserve(kNumChars);
+    for (size_t i = 0; i < kNumChars; ++i) {
+        str.push_back('a' + i % 26);
+    }
+    doNotOptimize(str);
+    report("push_back 1M chars, reserved", timer);
+}
+
+void benchShortStrings() {
+    Timer timer;
+    size_t total = 0;
+    for (size_t i = 0; i < kNumChars; ++i) {
+        string key("key");
+        key += 'a' + i % 26;
+        total += key.size();
+    }
+    doNotOptimize(total);
+    report("1M short keys", timer);
+}
+
+}  // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    benchPushBack();
+    benchAppendOperator();
+    benchAppendReserved();
+    benchShortStrings();
+    return 0;
+}
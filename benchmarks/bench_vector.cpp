@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "../include/vector"
+#ifndef ANDROID_ASTL_VECTOR__
+#error "Wrong header included!!"
+#endif
+#include <cstdio>
+#include "benchmark.h"
+
+namespace {
+using std::vector;
+
+// Non POD element: vector must copy construct it when growing.
+struct NonPod {
+    NonPod() : mValue(0) { }
+    NonPod(int value) : mValue(value) { }
+    NonPod(const NonPod& other) : mValue(other.mValue) { }
+    ~NonPod() { }
+    int mValue;
+};
+
+template<typename _T>
+void benchPushBack(const char *name, int num) {
+    Timer timer;
+    vector<_T> vec;
+    size_t reallocs = 0;
+    for (int i = 0; i < num; ++i) {
+        const size_t capacity = vec.capacity();
+        vec.push_back(_T(i));
+        reallocs += capacity != vec.capacity();
+    }
+    doNotOptimize(vec);
+    char comment[64];
+    std::snprintf(comment, sizeof(comment), "(%u reallocs)",
+                  static_cast<unsigned>(reallocs));
+    report(name, timer, comment);
+}
+
+// Erase the first element until the vector is empty: each erase
+// shifts the whole payload.
+template<typename _T>
+void benchEraseFront(const char *name, int num) {
+    vector<_T> vec;
+    for (int i = 0; i < num; ++i) {
+        vec.push_back(_T(i));
+    }
+    Timer timer;
+    while (!vec.empty()) {
+        vec.erase(vec.begin());
+    }
+    doNotOptimize(vec);
+    char comment[64];
+    const long long us = timer.elapsedUs();
+    // Bytes moved: sizeof(_T) * num * (num - 1) / 2.
+    std::snprintf(comment, sizeof(comment), "(%lld MB/s)",
+                  us > 0 ? static_cast<long long>(sizeof(_T)) * num / 2 *
+                  (num - 1) / us : 0LL);
+    report(name, timer, comment);
+}
+
+}  // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    benchPushBack<int>("push_back 10M ints", 10000000);
+    benchPushBack<NonPod>("push_back 1M non POD", 1000000);
+    benchEraseFront<int>("erase front 64K ints", 64 * 1024);
+    benchEraseFront<NonPod>("erase front 64K non POD", 64 * 1024);
+    return 0;
+}
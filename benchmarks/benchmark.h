@@ -0,0 +1,67 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ANDROID_ASTL_BENCHMARKS_BENCHMARK__
+#define ANDROID_ASTL_BENCHMARKS_BENCHMARK__
+#include <cstdio>
+#include <time.h>
+
+// Helpers used in benchmarks.
+namespace {
+
+// Measure the wall clock time elapsed since construction.
+class Timer {
+  public:
+    Timer() { clock_gettime(CLOCK_MONOTONIC, &mStart); }
+
+    // @return The number of microseconds elapsed.
+    long long elapsedUs() const {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (now.tv_sec - mStart.tv_sec) * 1000000LL +
+                (now.tv_nsec - mStart.tv_nsec) / 1000;
+    }
+  private:
+    struct timespec mStart;
+};
+
+// Print a result line: name, elapsed time and a free form comment.
+inline void report(const char *name, const Timer& timer,
+                   const char *comment = "") {
+    std::printf("%-40s %10lld us %s\n", name, timer.elapsedUs(), comment);
+}
+
+// Prevent the compiler from optimizing away a computed value.
+template<typename _T> inline void doNotOptimize(const _T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+}  // anonymous namespace
+
+#endif  // ANDROID_ASTL_BENCHMARKS_BENCHMARK__
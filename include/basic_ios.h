@@ -69,9 +69,26 @@ class basic_ios: public ios_base {
      */
     streambuf* rdbuf() const { return mStreambuf; }
 
+    /**
+     * @return The character used to pad the output up to width(),
+     * space by default.
+     */
+    char fill() const { return mFill; }
+
+    /**
+     * @param c The new fill character.
+     * @return The previous fill character.
+     */
+    char fill(char c) {
+        const char prev = mFill;
+        mFill = c;
+        return prev;
+    }
+
   protected:
     void init(streambuf* sb);
     streambuf* mStreambuf;
+    char mFill;
 };
 
 }  // namespace std
@@ -0,0 +1,249 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ANDROID_ASTL_DARY_HEAP_H__
+#define ANDROID_ASTL_DARY_HEAP_H__
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+#if defined(_T) || defined(_Arity) || defined(_Compare) || \
+    defined(_RandomAccessIterator) || defined(_Distance)
+#error "Macro(s) already defined."
+#endif
+
+// d-ary heaps. Not part of the STL -> android namespace.
+//
+// Same as the std heap algorithms but each node has _Arity children
+// (4 by default) at indexes _Arity * i + 1 ... _Arity * i + _Arity.
+// The tree is half as deep as a binary heap so push is cheaper and
+// pop touches half as many cache lines: the children of a node are
+// next to each other. pop does more comparisons per level, which is
+// cheap for small POD elements. Measure before switching: for
+// integers it wins on queues of steady size (push/pop interleaved)
+// but not when the queue is filled then drained.
+
+namespace android {
+
+// Move value up from hole, without going above top.
+template<size_t _Arity, typename _RandomAccessIterator, typename _Distance,
+         typename _T, typename _Compare>
+void __dary_sift_up(_RandomAccessIterator first, _Distance hole,
+                    _Distance top, _T value, _Compare comp) {
+    while (hole > top) {
+        const _Distance parent = (hole - 1) / _Arity;
+        if (!comp(*(first + parent), value)) {
+            break;
+        }
+        *(first + hole) = *(first + parent);
+        hole = parent;
+    }
+    *(first + hole) = value;
+}
+
+// @return The index of the greatest of the _Arity elements starting
+// at child. The selections are written as conditional moves: the
+// comparisons of random keys are not predictable.
+template<size_t _Arity>
+struct __dary_greatest_child {
+    template<typename _RandomAccessIterator, typename _Distance,
+             typename _Compare>
+    static _Distance get(_RandomAccessIterator first, _Distance child,
+                         _Compare comp) {
+        _Distance best = child;
+        for (_Distance i = child + 1; i < child + _Distance(_Arity); ++i) {
+            best = comp(*(first + best), *(first + i)) ? i : best;
+        }
+        return best;
+    }
+};
+
+// Two independent comparisons then a final one.
+template<>
+struct __dary_greatest_child<4> {
+    template<typename _RandomAccessIterator, typename _Distance,
+             typename _Compare>
+    static _Distance get(_RandomAccessIterator first, _Distance child,
+                         _Compare comp) {
+        const _Distance left = comp(*(first + child), *(first + (child + 1))) ?
+                child + 1 : child;
+        const _Distance right =
+                comp(*(first + (child + 2)), *(first + (child + 3))) ?
+                child + 3 : child + 2;
+        return comp(*(first + left), *(first + right)) ? right : left;
+    }
+};
+
+// Insert value in the heap of len elements where hole is free. Like
+// std::pop_heap, the hole goes down to a leaf following the greatest
+// children, then value goes up from there: value usually comes from
+// the bottom of the heap so this saves comparing it at each level.
+template<size_t _Arity, typename _RandomAccessIterator, typename _Distance,
+         typename _T, typename _Compare>
+void __dary_adjust_heap(_RandomAccessIterator first, _Distance hole,
+                        _Distance len, _T value, _Compare comp) {
+    const _Distance top = hole;
+    const _Distance arity = _Arity;
+    for (;;) {
+        const _Distance child = arity * hole + 1;
+        _Distance best = child;
+        if (len - child >= arity) {
+            best = __dary_greatest_child<_Arity>::get(first, child, comp);
+        } else if (child < len) {
+            for (_Distance i = child + 1; i < len; ++i) {
+                if (comp(*(first + best), *(first + i))) {
+                    best = i;
+                }
+            }
+        } else {
+            break;
+        }
+        *(first + hole) = *(first + best);
+        hole = best;
+    }
+    __dary_sift_up<_Arity>(first, hole, top, value, comp);
+}
+
+// Arrange the elements of [first, last) as a d-ary heap.
+template<size_t _Arity, typename _RandomAccessIterator, typename _Compare>
+void make_dary_heap(_RandomAccessIterator first, _RandomAccessIterator last,
+                    _Compare comp) {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::value_type
+            value_type;
+    typedef typename std::iterator_traits<_RandomAccessIterator>::
+            difference_type difference_type;
+    const difference_type len = last - first;
+    if (len < 2) {
+        return;
+    }
+    for (difference_type parent = (len - 2) / _Arity; parent >= 0; --parent) {
+        value_type value = *(first + parent);
+        __dary_adjust_heap<_Arity>(first, parent, len, value, comp);
+    }
+}
+
+// Insert the element at last - 1 in the d-ary heap [first, last - 1).
+template<size_t _Arity, typename _RandomAccessIterator, typename _Compare>
+void push_dary_heap(_RandomAccessIterator first, _RandomAccessIterator last,
+                    _Compare comp) {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::value_type
+            value_type;
+    typedef typename std::iterator_traits<_RandomAccessIterator>::
+            difference_type difference_type;
+    if (last - first < 2) {
+        return;
+    }
+    value_type value = *(last - 1);
+    __dary_sift_up<_Arity>(first, difference_type(last - first - 1),
+                           difference_type(0), value, comp);
+}
+
+// Move the greatest element of the d-ary heap [first, last) to
+// last - 1, [first, last - 1) remains a d-ary heap.
+template<size_t _Arity, typename _RandomAccessIterator, typename _Compare>
+void pop_dary_heap(_RandomAccessIterator first, _RandomAccessIterator last,
+                   _Compare comp) {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::value_type
+            value_type;
+    typedef typename std::iterator_traits<_RandomAccessIterator>::
+            difference_type difference_type;
+    if (last - first < 2) {
+        return;
+    }
+    --last;
+    value_type value = *last;
+    *last = *first;
+    __dary_adjust_heap<_Arity>(first, difference_type(0),
+                               difference_type(last - first), value, comp);
+}
+
+// @return true if [first, last) is a d-ary heap.
+template<size_t _Arity, typename _RandomAccessIterator, typename _Compare>
+bool is_dary_heap(_RandomAccessIterator first, _RandomAccessIterator last,
+                  _Compare comp) {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::
+            difference_type difference_type;
+    const difference_type len = last - first;
+    for (difference_type child = 1; child < len; ++child) {
+        if (comp(*(first + (child - 1) / _Arity), *(first + child))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Same interface as std::priority_queue, using a d-ary heap stored
+// in a std::vector.
+template<typename _T, size_t _Arity = 4, typename _Compare = std::less<_T> >
+class dary_priority_queue
+{
+  public:
+    typedef _T                                         value_type;
+    typedef typename std::vector<_T>::const_reference  const_reference;
+    typedef typename std::vector<_T>::size_type        size_type;
+
+    explicit dary_priority_queue(const _Compare& comp = _Compare())
+        : mComp(comp) { }
+
+    bool empty() const { return mHeap.empty(); }
+    size_type size() const { return mHeap.size(); }
+
+    // @return The greatest element. The queue must not be empty.
+    const_reference top() const { return mHeap.front(); }
+
+    // Insert a copy of elt.
+    void push(const value_type& elt) {
+        const size_type size = mHeap.size();
+        mHeap.push_back(elt);
+        if (mHeap.size() != size) {  // push_back can fail.
+            push_dary_heap<_Arity>(mHeap.begin(), mHeap.end(), mComp);
+        }
+    }
+
+    // Remove the greatest element. No-op if the queue is empty.
+    void pop() {
+        if (!mHeap.empty()) {
+            pop_dary_heap<_Arity>(mHeap.begin(), mHeap.end(), mComp);
+            mHeap.pop_back();
+        }
+    }
+
+    // Reserve memory for n elements.
+    bool reserve(size_type n) { return mHeap.reserve(n); }
+
+  private:
+    std::vector<_T> mHeap;
+    _Compare mComp;
+};
+
+}  // namespace android
+
+#endif  // ANDROID_ASTL_DARY_HEAP_H__
@@ -0,0 +1,109 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ANDROID_ASTL_EYTZINGER_H__
+#define ANDROID_ASTL_EYTZINGER_H__
+
+#include <cstddef>
+#include <algorithm>
+
+#if defined(_T) || defined(_V) || defined(_Compare)
+#error "Macro(s) already defined."
+#endif
+
+// Eytzinger layout of a sorted array. Not part of the STL -> android
+// namespace.
+//
+// The elements are stored in the order of a breadth first traversal
+// of the implicit binary search tree: the root at index 1, the
+// children of k at 2k and 2k + 1 (index 0 is not used). A lookup
+// walks down the tree from the start of the array, so the first
+// levels stay in cache and the nodes a few levels down are in a
+// single cache line which can be prefetched ahead. For large read
+// mostly tables this is faster than std::lower_bound on the sorted
+// array.
+//
+// The lookups return the index in the tree. Data associated to the
+// keys can be stored in a parallel array laid out with the same
+// function so the index addresses both.
+//
+// Example:
+//   std::vector<int> tree(keys.size() + 1);
+//   android::eytzinger_layout(&keys[0], keys.size(), &tree[0]);
+//   size_t k = android::eytzinger_lower_bound(&tree[0], keys.size(), 42);
+//   if (k != 0) { // tree[k] is the first key not less than 42.
+
+namespace android {
+
+template<typename _T>
+size_t __eytzinger_fill(const _T *sorted, size_t i, _T *tree, size_t k,
+                        size_t n) {
+    if (k <= n) {
+        i = __eytzinger_fill(sorted, i, tree, 2 * k, n);
+        tree[k] = sorted[i++];
+        i = __eytzinger_fill(sorted, i, tree, 2 * k + 1, n);
+    }
+    return i;
+}
+
+// Copy the sorted array [sorted, sorted + n) in Eytzinger order.
+// @param tree Array of n + 1 elements, tree[0] is not used.
+template<typename _T>
+void eytzinger_layout(const _T *sorted, size_t n, _T *tree) {
+    __eytzinger_fill(sorted, 0, tree, 1, n);
+}
+
+// @param tree The n elements laid out by eytzinger_layout.
+// @return The index in tree of the first element (in sorted order)
+// not less than val, 0 if there is none.
+template<typename _T, typename _V, typename _Compare>
+size_t eytzinger_lower_bound(const _T *tree, size_t n, const _V& val,
+                             _Compare comp) {
+    // Nodes 4 levels down from k (16 of them for 4 byte elements)
+    // share a cache line. Prefetching past the end is harmless.
+    const size_t kStride = sizeof(_T) < 64 ? 64 / sizeof(_T) : 1;
+    size_t k = 1;
+    while (k <= n) {
+        __builtin_prefetch(tree + k * kStride);
+        k = 2 * k + (comp(tree[k], val) ? 1 : 0);
+    }
+    // The bits of k are the path taken (1 = right). The answer is the
+    // last node where the search went left: drop the trailing right
+    // turns and that left turn.
+    return k >> __builtin_ffsl(static_cast<long>(~k));
+}
+
+template<typename _T, typename _V>
+size_t eytzinger_lower_bound(const _T *tree, size_t n, const _V& val) {
+    return eytzinger_lower_bound(tree, n, val, std::__less());
+}
+
+}  // namespace android
+
+#endif  // ANDROID_ASTL_EYTZINGER_H__
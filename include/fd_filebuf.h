@@ -0,0 +1,128 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ANDROID_ASTL_FD_FILEBUF__
+#define ANDROID_ASTL_FD_FILEBUF__
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+
+/**
+ * Stream buffer writing to a file descriptor (file, pipe, socket)
+ * with write(2) and writev(2), bypassing stdio.
+ *
+ * The output accumulates in a put area of buffer_size bytes. When a
+ * write does not fit, the put area and the new data are written
+ * together by a single writev. Partial writes are resumed and
+ * interrupted calls (EINTR) retried; any other error, including
+ * EAGAIN on a non blocking descriptor, makes the write fail and the
+ * data not yet written is dropped.
+ *
+ * sync() (std::flush, std::endl) writes the put area out, it does
+ * not call fsync.
+ */
+namespace android {
+
+class fd_filebuf: public std::streambuf
+{
+  public:
+    static const size_t kDefaultBufferSize = 64 * 1024;
+
+    // @param fd          Descriptor open for writing.
+    // @param buffer_size Size of the put area, 0 for none (every write
+    //                    is a system call).
+    // @param owns_fd     If true, the descriptor is closed by close()
+    //                    and the destructor.
+    explicit fd_filebuf(int fd, size_t buffer_size = kDefaultBufferSize,
+                        bool owns_fd = false);
+    virtual ~fd_filebuf();
+
+    int fd() const { return mFd; }
+    size_t buffer_size() const { return mBufferSize; }
+
+    // Write the put area out and replace it by one of size bytes.
+    // @return false if the put area could not be written or
+    // allocated, the buffer is then unchanged.
+    bool set_buffer_size(size_t size);
+
+    // Write the put area out and close the descriptor if owned.
+    // @return false if either failed.
+    bool close();
+
+  protected:
+    virtual std::streamsize xsputn(const char_type* str, std::streamsize num);
+    virtual int_type overflow(int_type c = traits_type::eof());
+    virtual int sync();
+
+  private:
+    // Write the put area and [str, str + num) out, in that order.
+    // The put area is empty on return.
+    // @return false on error.
+    bool FlushBuffer(const char_type *str = NULL, size_t num = 0);
+
+    int mFd;
+    bool mOwnsFd;
+    char_type *mBuffer;
+    size_t mBufferSize;
+};
+
+/**
+ * ofstream like output stream over an fd_filebuf.
+ *
+ *   android::fd_ofstream log("/data/log.txt", true);
+ *   log << "started" << std::endl;
+ */
+class fd_ofstream: public std::ostream
+{
+  public:
+    // Write to fd, which is not closed by the stream.
+    explicit fd_ofstream(int fd,
+                         size_t buffer_size = fd_filebuf::kDefaultBufferSize);
+
+    // Create or open path for writing. The file is truncated unless
+    // append is true. Check is_open() for errors.
+    explicit fd_ofstream(const char *path, bool append = false,
+                         size_t buffer_size = fd_filebuf::kDefaultBufferSize);
+    virtual ~fd_ofstream();
+
+    bool is_open() const { return mBuf.fd() >= 0; }
+
+    // Flush and, if the stream opened it, close the file.
+    bool close() { return mBuf.close(); }
+
+    fd_filebuf* rdbuf() { return &mBuf; }
+
+  private:
+    fd_filebuf mBuf;
+};
+
+}  // namespace android
+
+#endif  // ANDROID_ASTL_FD_FILEBUF__
@@ -0,0 +1,592 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ANDROID_ASTL_HASH_TABLE_H__
+#define ANDROID_ASTL_HASH_TABLE_H__
+
+// To include bionic's stl_pair.h, __STL_*_NAMESPACE must be defined.
+#ifndef __STL_BEGIN_NAMESPACE
+#define __STL_BEGIN_NAMESPACE namespace std {
+#define __STL_END_NAMESPACE   }
+#endif
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stl_pair.h>
+#include <iterator>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <type_traits.h>
+
+#if defined(_Key) || defined(_Value) || defined(_KeyOfValue) || \
+    defined(_Hash) || defined(_Equal)
+#error "Macro(s) already defined."
+#endif
+
+// Open addressing hash table used to implement the unordered
+// associative containers (unordered_set, unordered_map). Declared in
+// the android NS.
+//
+// The elements are stored in a single array of slots, there is no
+// node allocation per element. Collisions are resolved by linear
+// probing using Robin Hood hashing: on insertion, an element which is
+// closer to its home bucket gives its slot to the one being inserted
+// and moves down. This bounds the variance of the probe lengths and
+// lets lookups of missing keys stop early. Erase shifts the following
+// elements back instead of leaving tombstones.
+//
+// A control array of 1 byte per slot follows the slots in the same
+// allocation: 0 means empty, otherwise it is the distance of the
+// element to its home bucket plus 1. It is scanned to iterate and
+// during lookups, so most probes do not touch the elements. The
+// distance saturates at 255: beyond, only a poor hash function can
+// get there, it is computed again from the hash of the element.
+//
+// IMPORTANT: Since elements are moved around, erase and any insertion
+// that causes a rehash invalidate all the iterators.
+
+namespace android {
+
+// Forward iterators. They point to both the control byte and the slot
+// so ++ can skip the empty slots. The control array ends with a non
+// zero sentinel which is end().
+template<typename _Value>
+struct HashIterator
+{
+    typedef HashIterator<_Value> iterator_type;
+  public:
+    typedef ptrdiff_t                 difference_type;
+    typedef std::forward_iterator_tag iterator_category;
+    typedef _Value                    value_type;
+    typedef _Value*                   pointer;
+    typedef _Value&                   reference;
+
+    HashIterator(): mCtrl(), mSlot() { }
+    HashIterator(unsigned char *ctrl, _Value *slot): mCtrl(ctrl), mSlot(slot) { }
+
+    reference operator*() const { return *mSlot; }
+    pointer operator->() const { return mSlot; }
+
+    iterator_type& operator++() {
+        do { ++mCtrl; ++mSlot; } while (*mCtrl == 0);
+        return *this;
+    }
+    iterator_type operator++(int) {
+        iterator_type tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const iterator_type& o) const { return mCtrl == o.mCtrl; }
+    bool operator!=(const iterator_type& o) const { return mCtrl != o.mCtrl; }
+
+    unsigned char *mCtrl;
+    _Value *mSlot;
+};
+
+template<typename _Value>
+struct HashConstIterator
+{
+    typedef HashConstIterator<_Value> iterator_type;
+  public:
+    typedef ptrdiff_t                 difference_type;
+    typedef std::forward_iterator_tag iterator_category;
+    typedef _Value                    value_type;
+    typedef const _Value*             pointer;
+    typedef const _Value&             reference;
+
+    HashConstIterator(): mCtrl(), mSlot() { }
+    HashConstIterator(unsigned char *ctrl, _Value *slot): mCtrl(ctrl), mSlot(slot) { }
+    HashConstIterator(const HashIterator<_Value>& it): mCtrl(it.mCtrl), mSlot(it.mSlot) { }
+
+    reference operator*() const { return *mSlot; }
+    pointer operator->() const { return mSlot; }
+
+    iterator_type& operator++() {
+        do { ++mCtrl; ++mSlot; } while (*mCtrl == 0);
+        return *this;
+    }
+    iterator_type operator++(int) {
+        iterator_type tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    bool operator==(const iterator_type& o) const { return mCtrl == o.mCtrl; }
+    bool operator!=(const iterator_type& o) const { return mCtrl != o.mCtrl; }
+
+    unsigned char *mCtrl;
+    _Value *mSlot;
+};
+
+// Hash table of unique keys.
+// @param _Key Type of the keys.
+// @param _Value Type of the elements stored in the table.
+// @param _KeyOfValue Functor to extract the key from a value (see
+// android::Identity and android::SelectFirst in <functional>).
+// @param _Hash Functor returning the hash of a key as a size_t.
+// @param _Equal Functor comparing 2 keys for equality.
+template<typename _Key, typename _Value, typename _KeyOfValue,
+         typename _Hash, typename _Equal>
+class HashTable {
+  public:
+    typedef _Key                       key_type;
+    typedef _Value                     value_type;
+    typedef _Hash                      hasher;
+    typedef _Equal                     key_equal;
+    typedef HashIterator<_Value>       iterator;
+    typedef HashConstIterator<_Value>  const_iterator;
+    typedef size_t                     size_type;
+    typedef ptrdiff_t                  difference_type;
+
+    HashTable(size_type n, const _Hash& hash, const _Equal& equal)
+            : mHash(hash), mEqual(equal), mMaxLoadFactor(kDefaultMaxLoadFactor) {
+        init();
+        if (n > 0) rehash(n);
+    }
+    HashTable(const HashTable& other)
+            : mHash(other.mHash), mEqual(other.mEqual),
+              mMaxLoadFactor(other.mMaxLoadFactor) {
+        init();
+        copy(other);
+    }
+    ~HashTable() { release(); }
+
+    HashTable& operator=(const HashTable& other) {
+        if (this != &other) {
+            release();
+            init();
+            mHash = other.mHash;
+            mEqual = other.mEqual;
+            mMaxLoadFactor = other.mMaxLoadFactor;
+            copy(other);
+        }
+        return *this;
+    }
+
+    bool empty() const { return mLength == 0; }
+    size_type size() const { return mLength; }
+    size_type max_size() const {
+        return std::numeric_limits<size_type>::max() / (sizeof(value_type) + 1);
+    }
+    hasher hash_function() const { return mHash; }
+    key_equal key_eq() const { return mEqual; }
+
+    iterator begin() { return iterator(first()); }
+    const_iterator begin() const { return const_iterator(first()); }
+    iterator end() { return iterator(mCtrl + mCapacity, mSlots + mCapacity); }
+    const_iterator end() const {
+        return const_iterator(mCtrl + mCapacity, mSlots + mCapacity);
+    }
+
+    // Insert value if there is no element with an equal key.
+    // @return A pair made of an iterator to the element with an
+    // equal key and a bool which is true if value was inserted. If
+    // the table could not grow, the iterator is end() and the bool
+    // false.
+    std::pair<iterator, bool> insertUnique(const value_type& value);
+
+    // Remove the element at pos. Elements are shifted back to fill
+    // the slot: all the iterators are invalidated.
+    void erase(iterator pos);
+    size_type erase(const key_type& key);
+
+    // @return The element with a key equal to key or end().
+    iterator find(const key_type& key) {
+        const size_type idx = findIndex(key);
+        return iterator(mCtrl + idx, mSlots + idx);
+    }
+    const_iterator find(const key_type& key) const {
+        const size_type idx = findIndex(key);
+        return const_iterator(mCtrl + idx, mSlots + idx);
+    }
+
+    // Destroy all the elements. The buckets are kept.
+    void clear();
+
+    // Buckets and load factor. There is one element per bucket at
+    // most, the bucket count is always a power of 2.
+    size_type bucket_count() const { return mCapacity; }
+    float load_factor() const {
+        return mCapacity == 0 ? 0.0f : static_cast<float>(mLength) / mCapacity;
+    }
+    float max_load_factor() const { return mMaxLoadFactor; }
+
+    // Set the maximum load factor. Values outside of ]0, 1] are
+    // ignored. The table is rehashed if it is above the new maximum.
+    void max_load_factor(float mlf);
+
+    // Set the number of buckets to at least n and enough to hold the
+    // current elements under the maximum load factor. rehash(0)
+    // shrinks the table to fit.
+    // @return false if the memory could not be allocated, the table
+    // is then unchanged.
+    bool rehash(size_type n);
+
+    // Make room for n elements without rehashing.
+    bool reserve(size_type n) {
+        return rehash(static_cast<size_type>(n / mMaxLoadFactor) + 1);
+    }
+
+    void swap(HashTable& other) {
+        std::swap(mSlots, other.mSlots);
+        std::swap(mCtrl, other.mCtrl);
+        std::swap(mCapacity, other.mCapacity);
+        std::swap(mLength, other.mLength);
+        std::swap(mGrowAt, other.mGrowAt);
+        std::swap(mShift, other.mShift);
+        std::swap(mHash, other.mHash);
+        std::swap(mEqual, other.mEqual);
+        std::swap(mMaxLoadFactor, other.mMaxLoadFactor);
+    }
+
+  private:
+    static const size_type kMinCapacity = 8;
+    // Control byte of an empty slot. The others store the distance to
+    // the home bucket + 1, kSaturated if it does not fit in a byte.
+    static const unsigned char kEmpty = 0;
+    static const unsigned char kSaturated = 255;
+    static const float kDefaultMaxLoadFactor;
+
+    // Control byte of tables without buckets: only the end sentinel.
+    static unsigned char *emptyControl() {
+        static unsigned char sentinel = 1;
+        return &sentinel;
+    }
+
+    void init() {
+        mSlots = NULL;
+        mCtrl = emptyControl();
+        mCapacity = 0;
+        mLength = 0;
+        mGrowAt = 0;
+        mShift = 0;
+    }
+
+    // Destroy the elements and free the buckets.
+    void release();
+
+    static const key_type& key(const value_type& value) {
+        return _KeyOfValue()(value);
+    }
+
+    // Fibonacci hashing: multiply by 2^N / phi and keep the high
+    // bits. Spreads hash<int> and hash<T*> (identity functions) over
+    // the whole table.
+    size_type homeIndex(const key_type& key) const {
+        const size_type kGolden = sizeof(size_type) == 8 ?
+                static_cast<size_type>(0x9E3779B97F4A7C15ULL) :
+                static_cast<size_type>(0x9E3779B9UL);
+        return (mHash(key) * kGolden) >> mShift;
+    }
+
+    size_type nextIndex(size_type idx) const { return (idx + 1) & (mCapacity - 1); }
+
+    static unsigned char control(size_type dist) {
+        return dist < kSaturated ? static_cast<unsigned char>(dist) : kSaturated;
+    }
+
+    // @return The distance + 1 of the element in slot idx to its home.
+    size_type distance(size_type idx) const {
+        if (mCtrl[idx] != kSaturated) {
+            return mCtrl[idx];
+        }
+        return ((idx - homeIndex(key(mSlots[idx]))) & (mCapacity - 1)) + 1;
+    }
+
+    // @return true if the element in slot idx is at least dist - 1
+    // slots away from its home: a probe at distance dist goes past it.
+    bool probesPast(size_type idx, size_type dist) const {
+        if (mCtrl[idx] != kSaturated) {
+            return mCtrl[idx] >= dist;
+        }
+        return dist <= kSaturated || distance(idx) >= dist;
+    }
+
+    // @return The index of the element with a key equal to key or
+    // mCapacity if there is none.
+    size_type findIndex(const key_type& key) const;
+
+    iterator first() const;
+
+    // Move the element in src to the uninitialized slot dst.
+    static void relocate(value_type *dst, value_type *src) {
+        if (is_trivially_relocatable<value_type>::value) {
+            memcpy(static_cast<void*>(dst), static_cast<void*>(src), sizeof(value_type));
+        } else {
+            new (dst) value_type(*src);
+            src->~value_type();
+        }
+    }
+
+    // Robin Hood insertion of an element known not to be in the
+    // table. There must be an empty slot.
+    // @param src Relocated into the table if move is true, copied
+    // otherwise.
+    // @return The index of the new element.
+    size_type insertNew(const key_type& key, value_type *src, bool move);
+
+    void copy(const HashTable& other);
+
+    value_type *mSlots;
+    unsigned char *mCtrl;  // mCapacity + 1 bytes, the last one is the sentinel.
+    size_type mCapacity;
+    size_type mLength;
+    size_type mGrowAt;  // Rehash when the length goes above.
+    unsigned int mShift;  // Bits to drop from the mixed hash.
+    _Hash mHash;
+    _Equal mEqual;
+    float mMaxLoadFactor;
+};
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+const float HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::kDefaultMaxLoadFactor = 0.8f;
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+typename HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::iterator
+HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::first() const {
+    size_type idx = 0;
+    while (mCtrl[idx] == kEmpty) {  // Stops on the sentinel.
+        ++idx;
+    }
+    return iterator(mCtrl + idx, mSlots + idx);
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+typename HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::size_type
+HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::findIndex(const key_type& k) const {
+    if (mLength == 0) {
+        return mCapacity;
+    }
+    size_type idx = homeIndex(k);
+    // The residents are sorted by distance: once they are closer to
+    // their home than we are to ours, the key cannot be further.
+    for (size_type dist = 1; probesPast(idx, dist); ++dist) {
+        if (control(dist) == mCtrl[idx] && mEqual(key(mSlots[idx]), k)) {
+            return idx;
+        }
+        idx = nextIndex(idx);
+    }
+    return mCapacity;
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+typename HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::size_type
+HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::insertNew(const key_type& k,
+                                                              value_type *src,
+                                                              bool move) {
+    size_type idx = homeIndex(k);
+    size_type dist = 1;
+    while (probesPast(idx, dist)) {
+        idx = nextIndex(idx);
+        ++dist;
+    }
+    // idx is where the element goes. The residents up to the end of
+    // the run move one slot down.
+    size_type last = idx;
+    while (mCtrl[last] != kEmpty) {
+        last = nextIndex(last);
+    }
+    while (last != idx) {
+        const size_type prev = (last - 1) & (mCapacity - 1);
+        relocate(mSlots + last, mSlots + prev);
+        mCtrl[last] = control(mCtrl[prev] + 1);
+        last = prev;
+    }
+    mCtrl[idx] = control(dist);
+    if (move) {
+        relocate(mSlots + idx, src);
+    } else {
+        new (mSlots + idx) value_type(*src);
+    }
+    ++mLength;
+    return idx;
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+std::pair<typename HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::iterator, bool>
+HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::insertUnique(const value_type& value) {
+    const key_type& k = key(value);
+    size_type idx = findIndex(k);
+    if (idx != mCapacity) {
+        return std::pair<iterator, bool>(iterator(mCtrl + idx, mSlots + idx), false);
+    }
+    if (mLength + 1 > mGrowAt &&
+        !rehash(mCapacity == 0 ? kMinCapacity : mCapacity * 2)) {
+        return std::pair<iterator, bool>(end(), false);
+    }
+    idx = insertNew(k, const_cast<value_type*>(&value), false);
+    return std::pair<iterator, bool>(iterator(mCtrl + idx, mSlots + idx), true);
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+void HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::erase(iterator pos) {
+    size_type idx = pos.mCtrl - mCtrl;
+    if (idx >= mCapacity) {
+        return;
+    }
+    mSlots[idx].~value_type();
+    // Backward shift: pull the following elements of the run one slot
+    // closer to their home until one is already there or a slot is
+    // empty.
+    size_type next = nextIndex(idx);
+    while (mCtrl[next] > 1) {
+        mCtrl[idx] = control(distance(next) - 1);
+        relocate(mSlots + idx, mSlots + next);
+        idx = next;
+        next = nextIndex(next);
+    }
+    mCtrl[idx] = kEmpty;
+    --mLength;
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+typename HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::size_type
+HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::erase(const key_type& k) {
+    iterator pos = find(k);
+    if (pos == end()) {
+        return 0;
+    }
+    erase(pos);
+    return 1;
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+void HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::clear() {
+    if (mLength == 0) {
+        return;
+    }
+    if (!std::is_pod<value_type>::value) {
+        for (size_type i = 0; i < mCapacity; ++i) {
+            if (mCtrl[i] != kEmpty) {
+                mSlots[i].~value_type();
+            }
+        }
+    }
+    memset(mCtrl, kEmpty, mCapacity);
+    mLength = 0;
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+void HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::release() {
+    clear();
+    free(mSlots);
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+void HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::max_load_factor(float mlf) {
+    if (mlf > 0.0f && mlf <= 1.0f) {
+        mMaxLoadFactor = mlf;
+        rehash(0);
+    }
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+bool HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::rehash(size_type n) {
+    if (n == 0 && mLength == 0) {
+        release();
+        init();
+        return true;
+    }
+    const size_type needed = static_cast<size_type>(mLength / mMaxLoadFactor) + 1;
+    if (n < needed) {
+        n = needed;
+    }
+    if (n > max_size()) {
+        return false;
+    }
+    size_type capacity = kMinCapacity;
+    unsigned int shift = sizeof(size_type) * 8 - 3;
+    while (capacity < n) {
+        capacity *= 2;
+        --shift;
+    }
+    if (capacity == mCapacity) {
+        return true;
+    }
+
+    value_type *slots = static_cast<value_type*>(
+        malloc(capacity * (sizeof(value_type) + 1) + 1));
+    if (slots == NULL) {
+        return false;
+    }
+    unsigned char *const ctrl = reinterpret_cast<unsigned char*>(slots + capacity);
+    memset(ctrl, kEmpty, capacity);
+    ctrl[capacity] = 1;  // sentinel
+
+    value_type *const old_slots = mSlots;
+    unsigned char *const old_ctrl = mCtrl;
+    const size_type old_capacity = mCapacity;
+
+    mSlots = slots;
+    mCtrl = ctrl;
+    mCapacity = capacity;
+    mShift = shift;
+    mGrowAt = static_cast<size_type>(capacity * mMaxLoadFactor);
+    mLength = 0;
+    for (size_type i = 0; i < old_capacity; ++i) {
+        if (old_ctrl[i] != kEmpty) {
+            insertNew(key(old_slots[i]), old_slots + i, true);
+        }
+    }
+    free(old_slots);
+    return true;
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Hash, typename _Equal>
+void HashTable<_Key, _Value, _KeyOfValue, _Hash, _Equal>::copy(const HashTable& other) {
+    if (other.mLength == 0) {
+        return;
+    }
+    value_type *slots = static_cast<value_type*>(
+        malloc(other.mCapacity * (sizeof(value_type) + 1) + 1));
+    if (slots == NULL) {
+        return;
+    }
+    // Same hash functor and capacity: the elements keep their slot.
+    mSlots = slots;
+    mCtrl = reinterpret_cast<unsigned char*>(slots + other.mCapacity);
+    memcpy(mCtrl, other.mCtrl, other.mCapacity + 1);
+    mCapacity = other.mCapacity;
+    mLength = other.mLength;
+    mGrowAt = other.mGrowAt;
+    mShift = other.mShift;
+    for (size_type i = 0; i < mCapacity; ++i) {
+        if (mCtrl[i] != kEmpty) {
+            new (mSlots + i) value_type(other.mSlots[i]);
+        }
+    }
+}
+
+}  // namespace android
+
+#endif  // ANDROID_ASTL_HASH_TABLE_H__
@@ -0,0 +1,454 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ANDROID_ASTL_PARALLEL_H__
+#define ANDROID_ASTL_PARALLEL_H__
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits.h>
+
+#if defined(_T) || defined(_Body) || defined(_Compare) || \
+    defined(_RandomAccessIterator) || defined(_RandomAccessIterator1) || \
+    defined(_RandomAccessIterator2) || defined(_RandomAccessIterator3) || \
+    defined(_Function) || defined(_UnaryOperation) || \
+    defined(_BinaryOperation)
+#error "Macro(s) already defined."
+#endif
+
+// Parallel versions of fill, copy, transform, for_each, reduce and
+// sort for random access ranges. Not part of the STL -> android::par
+// namespace:
+//
+//   android::par::sort(vec.begin(), vec.end());
+//
+// The range is split in chunks of grain_size() elements (or more for
+// sort) which are processed by a pool of thread_count() threads, the
+// calling thread being one of them. Ranges of a single chunk are
+// processed on the calling thread.
+//
+// The functions return when all the chunks are done. The function
+// objects are copied for each chunk and called concurrently, they
+// must be thread safe. Only one parallel call runs at a time: calls
+// made while the pool is busy (from another thread or from a
+// function object) run on the calling thread.
+
+namespace android {
+namespace par {
+
+// Elements per chunk by default.
+const size_t kDefaultGrainSize = 32 * 1024;
+
+// Set the number of threads used, including the calling one. 0 (the
+// default) means one per online CPU. Must not be called while a
+// parallel algorithm runs.
+void set_thread_count(size_t count);
+size_t thread_count();
+
+// Set the minimum number of elements per chunk, 0 to restore
+// kDefaultGrainSize. Smaller chunks balance the load better but
+// cost more synchronization.
+void set_grain_size(size_t grain);
+size_t grain_size();
+
+// Work split in chunks, see run() below.
+class Job {
+  public:
+    virtual ~Job() { }
+    virtual void run(size_t chunk) = 0;
+};
+
+// Call job.run(i) for each i in [0, chunks), in any order and from
+// any of the pool's threads. Returns when all the calls are done.
+void run(Job& job, size_t chunks);
+
+// Job processing [0, size) in chunks of grain elements by calling
+// body(begin, end) for each.
+template<typename _Body>
+class RangeJob: public Job {
+  public:
+    RangeJob(_Body& body, size_t size, size_t grain)
+        : mBody(body), mSize(size), mGrain(grain) { }
+
+    virtual void run(size_t chunk) {
+        const size_t begin = chunk * mGrain;
+        mBody(begin, mSize - begin < mGrain ? mSize : begin + mGrain);
+    }
+
+  private:
+    _Body& mBody;
+    const size_t mSize;
+    const size_t mGrain;
+};
+
+// Call body(begin, end) on chunks of at least grain elements covering
+// [0, size).
+template<typename _Body>
+void parallel_for(size_t size, _Body& body, size_t grain) {
+    if (grain == 0) {
+        grain = 1;
+    }
+    const size_t chunks = size / grain + (size % grain != 0);
+    if (chunks <= 1 || thread_count() == 1) {
+        if (size > 0) {
+            body(0, size);
+        }
+        return;
+    }
+    RangeJob<_Body> job(body, size, grain);
+    run(job, chunks);
+}
+
+template<typename _Body>
+inline void parallel_for(size_t size, _Body& body) {
+    parallel_for(size, body, grain_size());
+}
+
+// Chunk bodies. The iterators are unwrapped (see android::iter).
+
+template<typename _RandomAccessIterator, typename _T>
+struct FillChunk {
+    FillChunk(_RandomAccessIterator first, const _T& value)
+        : mFirst(first), mValue(value) { }
+    void operator()(size_t begin, size_t end) {
+        std::fill(mFirst + begin, mFirst + end, mValue);
+    }
+    _RandomAccessIterator mFirst;
+    const _T mValue;
+};
+
+template<typename _RandomAccessIterator1, typename _RandomAccessIterator2>
+struct CopyChunk {
+    CopyChunk(_RandomAccessIterator1 first, _RandomAccessIterator2 result)
+        : mFirst(first), mResult(result) { }
+    void operator()(size_t begin, size_t end) {
+        std::copy(mFirst + begin, mFirst + end, mResult + begin);
+    }
+    _RandomAccessIterator1 mFirst;
+    _RandomAccessIterator2 mResult;
+};
+
+template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+         typename _UnaryOperation>
+struct TransformChunk {
+    TransformChunk(_RandomAccessIterator1 first,
+                   _RandomAccessIterator2 result, _UnaryOperation op)
+        : mFirst(first), mResult(result), mOp(op) { }
+    void operator()(size_t begin, size_t end) {
+        std::transform(mFirst + begin, mFirst + end, mResult + begin, mOp);
+    }
+    _RandomAccessIterator1 mFirst;
+    _RandomAccessIterator2 mResult;
+    _UnaryOperation mOp;
+};
+
+template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+         typename _RandomAccessIterator3, typename _BinaryOperation>
+struct Transform2Chunk {
+    Transform2Chunk(_RandomAccessIterator1 first1,
+                    _RandomAccessIterator2 first2,
+                    _RandomAccessIterator3 result, _BinaryOperation op)
+        : mFirst1(first1), mFirst2(first2), mResult(result), mOp(op) { }
+    void operator()(size_t begin, size_t end) {
+        std::transform(mFirst1 + begin, mFirst1 + end, mFirst2 + begin,
+                       mResult + begin, mOp);
+    }
+    _RandomAccessIterator1 mFirst1;
+    _RandomAccessIterator2 mFirst2;
+    _RandomAccessIterator3 mResult;
+    _BinaryOperation mOp;
+};
+
+template<typename _RandomAccessIterator, typename _Function>
+struct ForEachChunk {
+    ForEachChunk(_RandomAccessIterator first, _Function fn)
+        : mFirst(first), mFn(fn) { }
+    void operator()(size_t begin, size_t end) {
+        std::for_each(mFirst + begin, mFirst + end, mFn);
+    }
+    _RandomAccessIterator mFirst;
+    _Function mFn;
+};
+
+// Reduce each chunk to mPartials[chunk].
+template<typename _RandomAccessIterator, typename _T, typename _BinaryOperation>
+struct ReduceChunk {
+    ReduceChunk(_RandomAccessIterator first, _T *partials, size_t grain,
+                _BinaryOperation op)
+        : mFirst(first), mPartials(partials), mGrain(grain), mOp(op) { }
+    void operator()(size_t begin, size_t end) {
+        _BinaryOperation op(mOp);
+        _T acc = *(mFirst + begin);
+        for (size_t i = begin + 1; i < end; ++i) {
+            acc = op(acc, *(mFirst + i));
+        }
+        new (static_cast<void*>(mPartials + begin / mGrain)) _T(acc);
+    }
+    _RandomAccessIterator mFirst;
+    _T *mPartials;
+    const size_t mGrain;
+    _BinaryOperation mOp;
+};
+
+template<typename _RandomAccessIterator, typename _Compare>
+struct SortChunk {
+    SortChunk(_RandomAccessIterator first, _Compare comp)
+        : mFirst(first), mComp(comp) { }
+    void operator()(size_t begin, size_t end) {
+        std::sort(mFirst + begin, mFirst + end, mComp);
+    }
+    _RandomAccessIterator mFirst;
+    _Compare mComp;
+};
+
+// One round of the parallel merge sort: merge the pairs of adjacent
+// sorted runs of width elements from mSrc into mDst. Each merge is
+// split in mPieces chunks: piece j merges the j-th slice of the left
+// run with the elements of the right run which fall between the
+// slice's first element and the next slice's first element (found by
+// binary search), so the pieces write disjoint parts of the output.
+template<typename _T, typename _Compare>
+class MergeJob: public Job {
+  public:
+    MergeJob(const _T *src, _T *dst, size_t size, size_t width,
+             size_t pieces, _Compare comp)
+        : mSrc(src), mDst(dst), mSize(size), mWidth(width), mPieces(pieces),
+          mComp(comp) { }
+
+    virtual void run(size_t chunk) {
+        const size_t piece = chunk % mPieces;
+        const size_t lo = chunk / mPieces * 2 * mWidth;
+        const size_t mid = mSize - lo < mWidth ? mSize : lo + mWidth;
+        const size_t hi = mSize - mid < mWidth ? mSize : mid + mWidth;
+        if (mid == hi) {
+            // No right run: copied by the first piece.
+            if (piece == 0) {
+                std::copy(mSrc + lo, mSrc + hi, mDst + lo);
+            }
+            return;
+        }
+        const size_t left = mid - lo;
+        const _T *a_begin = mSrc + lo + left * piece / mPieces;
+        const _T *a_end = mSrc + lo + left * (piece + 1) / mPieces;
+        const _T *b_begin = piece == 0 ? mSrc + mid :
+                std::lower_bound(mSrc + mid, mSrc + hi, *a_begin, mComp);
+        const _T *b_end = piece == mPieces - 1 ? mSrc + hi :
+                std::lower_bound(mSrc + mid, mSrc + hi, *a_end, mComp);
+        _T *out = mDst + (a_begin - mSrc) + (b_begin - (mSrc + mid));
+        std::merge(a_begin, a_end, b_begin, b_end, out, mComp);
+    }
+
+  private:
+    const _T *mSrc;
+    _T *mDst;
+    const size_t mSize;
+    const size_t mWidth;
+    const size_t mPieces;
+    _Compare mComp;
+};
+
+// Fill [first, last) with copies of value.
+template<typename _RandomAccessIterator, typename _T>
+void fill(_RandomAccessIterator first, _RandomAccessIterator last,
+          const _T& value) {
+    typedef typename android::iter<_RandomAccessIterator>::iterator_type
+            iterator_type;
+    typedef typename std::iterator_traits<_RandomAccessIterator>::value_type
+            value_type;
+    FillChunk<iterator_type, value_type> body(
+        android::iter<_RandomAccessIterator>::base(first), value);
+    parallel_for(last - first, body);
+}
+
+// Copy [first, last) to [result, result + (last - first)).
+// @require The ranges do not overlap.
+// @return result + (last - first)
+template<typename _RandomAccessIterator1, typename _RandomAccessIterator2>
+_RandomAccessIterator2 copy(_RandomAccessIterator1 first,
+                            _RandomAccessIterator1 last,
+                            _RandomAccessIterator2 result) {
+    CopyChunk<_RandomAccessIterator1, _RandomAccessIterator2> body(first,
+                                                                   result);
+    parallel_for(last - first, body);
+    return result + (last - first);
+}
+
+// Assign op(*(first + i)) to *(result + i) for i in [0, last - first).
+// @return result + (last - first)
+template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+         typename _UnaryOperation>
+_RandomAccessIterator2 transform(_RandomAccessIterator1 first,
+                                 _RandomAccessIterator1 last,
+                                 _RandomAccessIterator2 result,
+                                 _UnaryOperation op) {
+    TransformChunk<_RandomAccessIterator1, _RandomAccessIterator2,
+                   _UnaryOperation> body(first, result, op);
+    parallel_for(last - first, body);
+    return result + (last - first);
+}
+
+// Assign op(*(first1 + i), *(first2 + i)) to *(result + i).
+// @return result + (last1 - first1)
+template<typename _RandomAccessIterator1, typename _RandomAccessIterator2,
+         typename _RandomAccessIterator3, typename _BinaryOperation>
+_RandomAccessIterator3 transform(_RandomAccessIterator1 first1,
+                                 _RandomAccessIterator1 last1,
+                                 _RandomAccessIterator2 first2,
+                                 _RandomAccessIterator3 result,
+                                 _BinaryOperation op) {
+    Transform2Chunk<_RandomAccessIterator1, _RandomAccessIterator2,
+                    _RandomAccessIterator3, _BinaryOperation>
+            body(first1, first2, result, op);
+    parallel_for(last1 - first1, body);
+    return result + (last1 - first1);
+}
+
+// Call fn on each element of [first, last), in no particular order.
+template<typename _RandomAccessIterator, typename _Function>
+void for_each(_RandomAccessIterator first, _RandomAccessIterator last,
+              _Function fn) {
+    ForEachChunk<_RandomAccessIterator, _Function> body(first, fn);
+    parallel_for(last - first, body);
+}
+
+// Combine init and the elements of [first, last) using op, which
+// must be associative: the chunks are reduced in parallel then their
+// results are combined in order.
+// @return The reduction, init if the range is empty.
+template<typename _RandomAccessIterator, typename _T, typename _BinaryOperation>
+_T reduce(_RandomAccessIterator first, _RandomAccessIterator last, _T init,
+          _BinaryOperation op) {
+    const size_t size = last - first;
+    const size_t grain = grain_size();
+    const size_t chunks = size / grain + (size % grain != 0);
+    _T *partials = NULL;
+    if (chunks > 1 && thread_count() > 1) {
+        partials = static_cast<_T*>(malloc(chunks * sizeof(_T)));
+    }
+    if (partials == NULL) {
+        for (; first != last; ++first) {
+            init = op(init, *first);
+        }
+        return init;
+    }
+    ReduceChunk<_RandomAccessIterator, _T, _BinaryOperation> body(
+        first, partials, grain, op);
+    RangeJob<ReduceChunk<_RandomAccessIterator, _T, _BinaryOperation> > job(
+        body, size, grain);
+    run(job, chunks);
+    for (size_t i = 0; i < chunks; ++i) {
+        init = op(init, partials[i]);
+        partials[i].~_T();
+    }
+    free(partials);
+    return init;
+}
+
+// Sum of init and the elements of [first, last).
+template<typename _RandomAccessIterator, typename _T>
+_T reduce(_RandomAccessIterator first, _RandomAccessIterator last, _T init) {
+    return reduce(first, last, init, std::plus<_T>());
+}
+
+// Sort [first, last) using comp: runs of at least grain_size()
+// elements, one per thread (rounded to a power of 2), are sorted in
+// parallel with std::sort then merged pairwise through a temporary
+// buffer. Falls back to std::sort when the range is small, is not
+// contiguous (pointers and vector iterators are) or the buffer cannot
+// be allocated.
+template<typename _RandomAccessIterator, typename _Compare>
+void sort(_RandomAccessIterator first, _RandomAccessIterator last,
+          _Compare comp) {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::value_type
+            value_type;
+    typedef typename android::iter<_RandomAccessIterator>::iterator_type
+            iterator_type;
+    const size_t size = last - first;
+    const size_t threads = thread_count();
+    const size_t grain = grain_size();
+
+    size_t runs = 1;
+    while (std::is_pointer<iterator_type>::value && runs < threads &&
+           size / (2 * runs) >= grain) {
+        runs *= 2;
+    }
+    value_type *buffer = NULL;
+    if (runs > 1) {
+        buffer = static_cast<value_type*>(malloc(size * sizeof(value_type)));
+    }
+    if (buffer == NULL) {
+        std::sort(first, last, comp);
+        return;
+    }
+    value_type *const data = &*first;
+    const size_t width = size / runs + (size % runs != 0);
+    SortChunk<value_type*, _Compare> sorter(data, comp);
+    parallel_for(size, sorter, width);
+
+    // Merge rounds, swapping the source and the destination.
+    const bool pod = std::is_pod<value_type>::value;
+    if (!pod) {
+        std::uninitialized_copy(data, data + size, buffer);
+    }
+    value_type *src = data;
+    value_type *dst = buffer;
+    for (size_t w = width; w < size; w *= 2) {
+        const size_t pairs = size / (2 * w) + (size % (2 * w) != 0);
+        const size_t pieces = threads > pairs ? threads / pairs : 1;
+        MergeJob<value_type, _Compare> job(src, dst, size, w, pieces, comp);
+        run(job, pairs * pieces);
+        std::swap(src, dst);
+    }
+    if (src != data) {
+        android::par::copy(src, src + size, data);
+    }
+    if (!pod) {
+        for (size_t i = 0; i < size; ++i) {
+            buffer[i].~value_type();
+        }
+    }
+    free(buffer);
+}
+
+template<typename _RandomAccessIterator>
+inline void sort(_RandomAccessIterator first, _RandomAccessIterator last) {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::value_type
+            value_type;
+    android::par::sort(first, last, std::less<value_type>());
+}
+
+}  // namespace par
+}  // namespace android
+
+#endif  // ANDROID_ASTL_PARALLEL_H__
@@ -0,0 +1,170 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ANDROID_ASTL_RADIX_SORT_H__
+#define ANDROID_ASTL_RADIX_SORT_H__
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <type_traits.h>
+
+#if defined(_T) || defined(_Key) || defined(_Size) || defined(_IsIntegral)
+#error "Macro(s) already defined."
+#endif
+
+// LSD radix sort for arrays of integers. Not part of the STL ->
+// android namespace.
+//
+// The keys are sorted one byte at a time, least significant first,
+// using counting sort: each pass reads the keys once and writes them
+// once to a buffer of the same size. All the histograms are computed
+// in a single pass beforehand and the passes where all the keys have
+// the same digit are skipped (e.g the high bytes of small values).
+// This is O(n * sizeof(_T)) and beats comparison sorts on large
+// arrays, while std::sort is used on small ones (below
+// kRadixSortMinSize elements per byte of key).
+//
+// Signed types are sorted by flipping the sign bit of the most
+// significant digit. The sort is stable.
+//
+// Other element types fall back to std::sort, so radix_sort can be
+// used in generic code.
+
+namespace android {
+
+// Below this size times sizeof(key) std::sort is faster: each byte
+// of the key costs a pass over the data.
+const size_t kRadixSortMinSize = 256;
+
+// Unsigned integer type of a given size used to extract the digits.
+template<size_t _Size> struct RadixKey;
+template<> struct RadixKey<1> { typedef unsigned char type; };
+template<> struct RadixKey<2> { typedef unsigned short type; };
+template<> struct RadixKey<4> { typedef unsigned int type; };
+template<> struct RadixKey<8> { typedef unsigned long long type; };
+
+template<bool _IsIntegral>
+struct RadixSort {
+    template<typename _T>
+    static void sort(_T *first, _T *last) { std::sort(first, last); }
+};
+
+template<>
+struct RadixSort<true> {
+    template<typename _T>
+    static void sort(_T *first, _T *last);
+};
+
+template<typename _T>
+void RadixSort<true>::sort(_T *first, _T *last) {
+    typedef typename RadixKey<sizeof(_T)>::type key_type;
+    const size_t kDigits = sizeof(_T);
+    const size_t kRadix = 256;
+    // XOR'ed with the most significant digit of signed types so the
+    // negative values come first.
+    const size_t kSignFlip = _T(-1) < _T(0) ? 0x80 : 0;
+
+    const size_t n = last - first;
+    if (n < kRadixSortMinSize * kDigits) {
+        std::sort(first, last);
+        return;
+    }
+    // One allocation for the buffer and the histograms. The
+    // histograms start on a size_t boundary: n chars or shorts may
+    // leave the end of the buffer misaligned.
+    const size_t counts_offset =
+        (n * sizeof(_T) + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+    _T *buffer = static_cast<_T*>(
+        malloc(counts_offset + kDigits * kRadix * sizeof(size_t)));
+    if (buffer == NULL) {
+        std::sort(first, last);
+        return;
+    }
+    size_t *const counts = reinterpret_cast<size_t*>(
+        reinterpret_cast<char*>(buffer) + counts_offset);
+    memset(counts, 0, kDigits * kRadix * sizeof(size_t));
+
+    for (const _T *i = first; i != last; ++i) {
+        const key_type key = static_cast<key_type>(*i);
+        for (size_t d = 0; d < kDigits - 1; ++d) {
+            ++counts[d * kRadix + ((key >> (8 * d)) & 0xff)];
+        }
+        ++counts[(kDigits - 1) * kRadix +
+                 (((key >> (8 * (kDigits - 1))) & 0xff) ^ kSignFlip)];
+    }
+
+    _T *src = first;
+    _T *dst = buffer;
+    for (size_t d = 0; d < kDigits; ++d) {
+        size_t *const offsets = counts + d * kRadix;
+        const size_t shift = 8 * d;
+        const size_t flip = d == kDigits - 1 ? kSignFlip : 0;
+        const size_t digit = ((static_cast<key_type>(*src) >> shift) & 0xff) ^ flip;
+        if (offsets[digit] == n) {
+            continue;  // Same digit everywhere: nothing to do.
+        }
+        // Turn the counts into the first position of each digit.
+        size_t sum = 0;
+        for (size_t b = 0; b < kRadix; ++b) {
+            const size_t count = offsets[b];
+            offsets[b] = sum;
+            sum += count;
+        }
+        for (const _T *i = src; i != src + n; ++i) {
+            const size_t b = ((static_cast<key_type>(*i) >> shift) & 0xff) ^ flip;
+            dst[offsets[b]++] = *i;
+        }
+        std::swap(src, dst);
+    }
+    if (src != first) {
+        memcpy(first, src, n * sizeof(_T));
+    }
+    free(buffer);
+}
+
+// Sort the integers in [first, last) in ascending order.
+template<typename _T>
+inline void radix_sort(_T *first, _T *last) {
+    RadixSort<std::is_integral<_T>::value>::sort(first, last);
+}
+
+// Sort the elements of vec in ascending order.
+template<typename _T>
+inline void radix_sort(std::vector<_T>& vec) {
+    if (!vec.empty()) {
+        radix_sort(&vec[0], &vec[0] + vec.size());
+    }
+}
+
+}  // namespace android
+
+#endif  // ANDROID_ASTL_RADIX_SORT_H__
@@ -30,6 +30,7 @@
 #ifndef ANDROID_ASTL_STDIO_FILEBUF__
 #define ANDROID_ASTL_STDIO_FILEBUF__
 
+#include <cstddef>
 #include <cstdio>
 #include <streambuf>
 #include <ios_pos_types.h>
@@ -37,22 +38,37 @@
 /**
  * Implementation of the streambuf used to build the cout and cerr
  * streams.
+ *
+ * Buffered instances accumulate the output in their own put area
+ * which is written to the stream in one fwrite when it is full or
+ * when the buffer is synced (e.g std::flush, std::endl). Output
+ * written directly to the FILE (e.g printf) may therefore appear
+ * before the buffered one. Unbuffered instances (cerr) call fwrite on
+ * every write.
  */
 namespace android {
 
 class stdio_filebuf: public std::streambuf
 {
   public:
-    stdio_filebuf(std::FILE* stream);
+    static const size_t kBufferSize = 4096;
+
+    stdio_filebuf(std::FILE* stream, bool buffered = true);
     virtual ~stdio_filebuf();
 
   protected:
     // These are the concrete implementations declared in ostream.
     virtual std::streamsize xsputn(const char_type* str, std::streamsize num);
+    virtual int_type overflow(int_type c = traits_type::eof());
     virtual int sync();
 
   private:
+    // Write the put area to the stream and empty it.
+    // @return false if fwrite failed.
+    bool FlushBuffer();
+
     FILE *mStream;
+    char_type mBuffer[kBufferSize];
 };
 
 }  // namespace android
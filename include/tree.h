@@ -0,0 +1,457 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ANDROID_ASTL_TREE_H__
+#define ANDROID_ASTL_TREE_H__
+
+// To include bionic's stl_pair.h, __STL_*_NAMESPACE must be defined.
+#ifndef __STL_BEGIN_NAMESPACE
+#define __STL_BEGIN_NAMESPACE namespace std {
+#define __STL_END_NAMESPACE   }
+#endif
+
+#include <cstddef>
+#include <stl_pair.h>
+#include <iterator>
+#include <limits>
+#include <algorithm>
+#include <functional>
+
+#if defined(_Key) || defined(_Value) || defined(_KeyOfValue) || \
+    defined(_Compare)
+#error "Macro(s) already defined."
+#endif
+
+// Red-black tree used to implement the ordered associative containers
+// (set, map). The nodes, iterators and the tree are declared in the
+// android NS.
+//
+// The code to walk and rebalance the tree does not depend on the type
+// of the elements, it lives in src/tree.cpp. Only the allocation and
+// the comparison of the keys are templatized.
+
+namespace android {
+
+// The header is a special node: its parent is the root of the tree,
+// its left and right are the leftmost and rightmost nodes. When the
+// tree is empty, the root is NULL and left and right point to the
+// header. The header represents end(), it is red to distinguish it
+// from the root in prev().
+struct TreeNodeBase {
+    enum Color { kRed = 0, kBlack = 1 };
+
+    TreeNodeBase *mParent;
+    TreeNodeBase *mLeft;
+    TreeNodeBase *mRight;
+    Color mColor;
+
+    // Initialize a header for an empty tree.
+    void init();
+
+    // @return The leftmost/rightmost node in the subtree rooted at
+    // node. node must not be NULL.
+    static TreeNodeBase *minimum(TreeNodeBase *node);
+    static TreeNodeBase *maximum(TreeNodeBase *node);
+
+    // In-order traversal.
+    // @return The next/previous node. The header follows the
+    // rightmost node.
+    static TreeNodeBase *next(TreeNodeBase *node);
+    static TreeNodeBase *prev(TreeNodeBase *node);
+
+    // Link node as a child of parent and rebalance the tree.
+    // @param insert_left Insert as the left child, must be true if
+    // parent is the header (empty tree).
+    // @param node To be inserted.
+    // @param parent Node with a NULL left (resp. right) child.
+    // @param header Of the tree.
+    static void insertAndRebalance(bool insert_left, TreeNodeBase *node,
+                                   TreeNodeBase *parent,
+                                   TreeNodeBase& header);
+
+    // Unlink node from the tree and rebalance it. The other nodes are
+    // relinked, not copied: iterators to them remain valid.
+    // @param node To be removed, not the header.
+    // @param header Of the tree.
+    static void eraseAndRebalance(TreeNodeBase *node, TreeNodeBase& header);
+
+    // Swap the content of 2 trees given their headers.
+    static void swap(TreeNodeBase& a, TreeNodeBase& b);
+};
+
+template <typename _T>
+struct TreeNode: public TreeNodeBase {
+    explicit TreeNode(const _T& data): mData(data) { }
+    _T mData;
+};
+
+// iterators: TreeIterator and TreeConstIterator are bidirectional ones.
+template<typename _T>
+struct TreeIterator
+{
+    typedef TreeIterator<_T>      iterator_type;
+    typedef android::TreeNode<_T> node_type;
+  public:
+    typedef ptrdiff_t                       difference_type;
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef _T                              value_type;
+    typedef _T*                             pointer;
+    typedef _T&                             reference;
+
+    TreeIterator():
+        mNode() { }
+
+    explicit TreeIterator(TreeNodeBase* node):
+        mNode(node) { }
+
+    reference operator*() const { return static_cast<node_type*>(mNode)->mData; }
+    pointer operator->() const { return &operator*(); }
+
+    iterator_type& operator++() { mNode = TreeNodeBase::next(mNode); return *this; }
+    iterator_type operator++(int) {
+        iterator_type tmp = *this;
+        mNode = TreeNodeBase::next(mNode);
+        return tmp;
+    }
+
+    iterator_type& operator--() { mNode = TreeNodeBase::prev(mNode); return *this; }
+    iterator_type operator--(int) {
+        iterator_type tmp = *this;
+        mNode = TreeNodeBase::prev(mNode);
+        return tmp;
+    }
+
+    bool operator==(const iterator_type& o) const { return mNode == o.mNode; }
+    bool operator!=(const iterator_type& o) const { return mNode != o.mNode; }
+
+    TreeNodeBase *mNode;
+};
+
+template<typename _T>
+struct TreeConstIterator
+{
+    typedef TreeConstIterator<_T> iterator_type;
+    typedef android::TreeNode<_T> node_type;
+  public:
+    typedef ptrdiff_t                       difference_type;
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef _T                              value_type;
+    typedef const _T*                       pointer;
+    typedef const _T&                       reference;
+
+    TreeConstIterator():
+        mNode() { }
+
+    explicit TreeConstIterator(TreeNodeBase* node):
+        mNode(node) { }
+
+    TreeConstIterator(const TreeIterator<_T>& it): mNode(it.mNode) { }
+
+    reference operator*() const { return static_cast<node_type*>(mNode)->mData; }
+    pointer operator->() const { return &operator*(); }
+
+    iterator_type& operator++() { mNode = TreeNodeBase::next(mNode); return *this; }
+    iterator_type operator++(int) {
+        iterator_type tmp = *this;
+        mNode = TreeNodeBase::next(mNode);
+        return tmp;
+    }
+
+    iterator_type& operator--() { mNode = TreeNodeBase::prev(mNode); return *this; }
+    iterator_type operator--(int) {
+        iterator_type tmp = *this;
+        mNode = TreeNodeBase::prev(mNode);
+        return tmp;
+    }
+
+    bool operator==(const iterator_type& o) const { return mNode == o.mNode; }
+    bool operator!=(const iterator_type& o) const { return mNode != o.mNode; }
+
+    TreeNodeBase *mNode;
+};
+
+// Red-black tree of unique keys.
+// @param _Key Type of the keys.
+// @param _Value Type of the elements stored in the tree.
+// @param _KeyOfValue Functor to extract the key from a value (see
+// android::Identity and android::SelectFirst in <functional>).
+// @param _Compare Strict weak ordering of the keys.
+template<typename _Key, typename _Value, typename _KeyOfValue,
+         typename _Compare>
+class Tree {
+    typedef android::TreeNode<_Value> node_type;
+  public:
+    typedef _Key                            key_type;
+    typedef _Value                          value_type;
+    typedef _Compare                        key_compare;
+    typedef TreeIterator<_Value>            iterator;
+    typedef TreeConstIterator<_Value>       const_iterator;
+    typedef size_t                          size_type;
+    typedef ptrdiff_t                       difference_type;
+
+    explicit Tree(const _Compare& comp): mCompare(comp) { init(); }
+    Tree(const Tree& other): mCompare(other.mCompare) { init(); copy(other); }
+    ~Tree() { clear(); }
+
+    Tree& operator=(const Tree& other) {
+        if (this != &other) {
+            clear();
+            mCompare = other.mCompare;
+            copy(other);
+        }
+        return *this;
+    }
+
+    void clear() {
+        eraseSubtree(mHeader.mParent);
+        init();
+    }
+
+    bool empty() const { return mLength == 0; }
+    size_type size() const { return mLength; }
+    size_type max_size() const { return std::numeric_limits<size_type>::max(); }
+    key_compare key_comp() const { return mCompare; }
+
+    iterator begin() { return iterator(mHeader.mLeft); }
+    const_iterator begin() const { return const_iterator(mHeader.mLeft); }
+    iterator end() { return iterator(&mHeader); }
+    const_iterator end() const { return const_iterator(header()); }
+
+    // Insert value if there is no element with an equivalent key.
+    // @return A pair made of an iterator to the element with an
+    // equivalent key and a bool which is true if value was inserted.
+    std::pair<iterator, bool> insertUnique(const value_type& value);
+
+    void erase(iterator pos);
+    size_type erase(const key_type& key);
+    void erase(iterator first, iterator last);
+
+    // @return The first element whose key is not less than key.
+    iterator lowerBound(const key_type& key) { return iterator(lowerBoundNode(key)); }
+    const_iterator lowerBound(const key_type& key) const {
+        return const_iterator(lowerBoundNode(key));
+    }
+
+    // @return The first element whose key is greater than key.
+    iterator upperBound(const key_type& key) { return iterator(upperBoundNode(key)); }
+    const_iterator upperBound(const key_type& key) const {
+        return const_iterator(upperBoundNode(key));
+    }
+
+    // @return The element with a key equivalent to key or end().
+    iterator find(const key_type& key) { return iterator(findNode(key)); }
+    const_iterator find(const key_type& key) const {
+        return const_iterator(findNode(key));
+    }
+
+    void swap(Tree& other) {
+        TreeNodeBase::swap(mHeader, other.mHeader);
+        std::swap(mLength, other.mLength);
+        std::swap(mCompare, other.mCompare);
+    }
+
+  private:
+    void init() {
+        mHeader.init();
+        mLength = 0;
+    }
+
+    TreeNodeBase *header() const { return const_cast<TreeNodeBase*>(&mHeader); }
+
+    static const key_type& key(const TreeNodeBase *node) {
+        return _KeyOfValue()(static_cast<const node_type*>(node)->mData);
+    }
+
+    TreeNodeBase *lowerBoundNode(const key_type& key) const;
+    TreeNodeBase *upperBoundNode(const key_type& key) const;
+    TreeNodeBase *findNode(const key_type& key) const;
+
+    // Delete all the nodes in the subtree rooted at node.
+    void eraseSubtree(TreeNodeBase *node);
+
+    // Clone the nodes of other. This tree must be empty.
+    void copy(const Tree& other);
+    TreeNodeBase *copySubtree(const TreeNodeBase *node, TreeNodeBase *parent);
+
+    size_type mLength;
+    // mHeader does not contain any data, it represents end().
+    TreeNodeBase mHeader;
+    _Compare mCompare;
+};
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Compare>
+std::pair<typename Tree<_Key, _Value, _KeyOfValue, _Compare>::iterator, bool>
+Tree<_Key, _Value, _KeyOfValue, _Compare>::insertUnique(const value_type& value) {
+    const key_type& k = _KeyOfValue()(value);
+    TreeNodeBase *parent = &mHeader;
+    TreeNodeBase *node = mHeader.mParent;
+    bool less = true;
+
+    // Find the leaf where the value would go.
+    while (node != NULL) {
+        parent = node;
+        less = mCompare(k, key(node));
+        node = less ? node->mLeft : node->mRight;
+    }
+    // The only candidate for an equivalent key is the predecessor.
+    TreeNodeBase *pred = parent;
+    if (less) {
+        if (parent == mHeader.mLeft) {  // parent is begin(), no predecessor
+            pred = NULL;
+        } else {
+            pred = TreeNodeBase::prev(parent);
+        }
+    }
+    if (pred != NULL && !mCompare(key(pred), k)) {
+        return std::pair<iterator, bool>(iterator(pred), false);
+    }
+    if (mLength + 1 < mLength) {
+        return std::pair<iterator, bool>(end(), false);  // overflow
+    }
+
+    const bool insert_left = parent == &mHeader || less;
+    node = new node_type(value);
+    TreeNodeBase::insertAndRebalance(insert_left, node, parent, mHeader);
+    ++mLength;
+    return std::pair<iterator, bool>(iterator(node), true);
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Compare>
+void Tree<_Key, _Value, _KeyOfValue, _Compare>::erase(iterator pos) {
+    if (pos.mNode != &mHeader) {
+        TreeNodeBase::eraseAndRebalance(pos.mNode, mHeader);
+        delete static_cast<node_type*>(pos.mNode);
+        --mLength;
+    }
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Compare>
+typename Tree<_Key, _Value, _KeyOfValue, _Compare>::size_type
+Tree<_Key, _Value, _KeyOfValue, _Compare>::erase(const key_type& k) {
+    iterator pos = find(k);
+    if (pos == end()) {
+        return 0;
+    }
+    erase(pos);
+    return 1;
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Compare>
+void Tree<_Key, _Value, _KeyOfValue, _Compare>::erase(iterator first, iterator last) {
+    if (first == begin() && last == end()) {
+        clear();
+        return;
+    }
+    while (first != last) {
+        erase(first++);
+    }
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Compare>
+TreeNodeBase *
+Tree<_Key, _Value, _KeyOfValue, _Compare>::lowerBoundNode(const key_type& k) const {
+    TreeNodeBase *res = header();
+    TreeNodeBase *node = mHeader.mParent;
+    while (node != NULL) {
+        if (!mCompare(key(node), k)) {
+            res = node;
+            node = node->mLeft;
+        } else {
+            node = node->mRight;
+        }
+    }
+    return res;
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Compare>
+TreeNodeBase *
+Tree<_Key, _Value, _KeyOfValue, _Compare>::upperBoundNode(const key_type& k) const {
+    TreeNodeBase *res = header();
+    TreeNodeBase *node = mHeader.mParent;
+    while (node != NULL) {
+        if (mCompare(k, key(node))) {
+            res = node;
+            node = node->mLeft;
+        } else {
+            node = node->mRight;
+        }
+    }
+    return res;
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Compare>
+TreeNodeBase *
+Tree<_Key, _Value, _KeyOfValue, _Compare>::findNode(const key_type& k) const {
+    TreeNodeBase *res = lowerBoundNode(k);
+    if (res == &mHeader || mCompare(k, key(res))) {
+        return header();
+    }
+    return res;
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Compare>
+void Tree<_Key, _Value, _KeyOfValue, _Compare>::eraseSubtree(TreeNodeBase *node) {
+    // Recurse on the right, loop on the left. The tree is balanced so
+    // the recursion depth is O(log n).
+    while (node != NULL) {
+        eraseSubtree(node->mRight);
+        TreeNodeBase *left = node->mLeft;
+        delete static_cast<node_type*>(node);
+        node = left;
+    }
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Compare>
+void Tree<_Key, _Value, _KeyOfValue, _Compare>::copy(const Tree& other) {
+    if (other.mHeader.mParent != NULL) {
+        mHeader.mParent = copySubtree(other.mHeader.mParent, &mHeader);
+        mHeader.mLeft = TreeNodeBase::minimum(mHeader.mParent);
+        mHeader.mRight = TreeNodeBase::maximum(mHeader.mParent);
+        mLength = other.mLength;
+    }
+}
+
+template<typename _Key, typename _Value, typename _KeyOfValue, typename _Compare>
+TreeNodeBase *
+Tree<_Key, _Value, _KeyOfValue, _Compare>::copySubtree(const TreeNodeBase *node,
+                                                       TreeNodeBase *parent) {
+    if (node == NULL) {
+        return NULL;
+    }
+    TreeNodeBase *res = new node_type(static_cast<const node_type*>(node)->mData);
+    res->mColor = node->mColor;
+    res->mParent = parent;
+    res->mLeft = copySubtree(node->mLeft, res);
+    res->mRight = copySubtree(node->mRight, res);
+    return res;
+}
+
+}  // namespace android
+
+#endif  // ANDROID_ASTL_TREE_H__
@@ -164,4 +164,35 @@ struct is_class: public integral_constant<bool, sizeof(test_pod_type<_T>(0)) ==
 
 }  // namespace std
 
+namespace android {
+
+// is_trivially_relocatable
+// An instance of a trivially relocatable type can be moved to a new
+// address with memcpy/realloc, the original being discarded without
+// calling its destructor. Containers use it to grow their storage
+// without copy constructing each element. PODs are trivially
+// relocatable, other types must opt in explicitely by specializing
+// this template (e.g. types with no pointer into themselves). Not
+// part of the STL -> android namespace.
+template<typename _T>
+struct is_trivially_relocatable
+        : public std::integral_constant<bool, std::is_pod<_T>::value> { };
+
+}  // namespace android
+
+namespace std {
+template<class _T1, class _T2> struct pair;  // see stl_pair.h
+}  // namespace std
+
+namespace android {
+
+// A pair is relocatable if both its members are.
+template<typename _T1, typename _T2>
+struct is_trivially_relocatable<std::pair<_T1, _T2> >
+        : public std::integral_constant<bool,
+                                        is_trivially_relocatable<_T1>::value &&
+                                        is_trivially_relocatable<_T2>::value> { };
+
+}  // namespace android
+
 #endif  // ANDROID_ASTL_TYPE_TRAITS_H__
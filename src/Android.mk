@@ -18,15 +18,26 @@ LOCAL_PATH := $(call my-dir)
 
 astl_common_src_files := \
     basic_ios.cpp \
+    fd_filebuf.cpp \
+    fill.cpp \
+    fill_avx2.cpp \
+    fill_sse2.cpp \
+    find.cpp \
+    find_avx2.cpp \
+    find_sse2.cpp \
+    float_to_decimal.cpp \
+    hash.cpp \
     ios_base.cpp \
     ios_globals.cpp \
     ios_pos_types.cpp \
     list.cpp \
     ostream.cpp \
+    parallel.cpp \
     sstream.cpp \
     stdio_filebuf.cpp \
     streambuf.cpp \
-    string.cpp
+    string.cpp \
+    tree.cpp
 
 # Target build
 include $(CLEAR_VARS)
@@ -31,7 +31,7 @@
 namespace std {
 
 basic_ios::basic_ios()
-    : mStreambuf(0) {}
+    : mStreambuf(0), mFill(' ') {}
 
 // Empty on purpose.
 basic_ios::~basic_ios() {}
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <fd_filebuf.h>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace {
+
+// Write the iovecs out, resuming partial writes and retrying
+// interrupted calls.
+// @return false on error.
+bool writeAll(int fd, struct iovec *iov, int count) {
+    for (;;) {
+        // Skip what has been written (or was empty).
+        while (count > 0 && iov->iov_len == 0) {
+            ++iov;
+            --count;
+        }
+        if (count == 0) {
+            return true;
+        }
+        const ssize_t written = count == 1 ?
+                write(fd, iov->iov_base, iov->iov_len) :
+                writev(fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        if (written == 0) {
+            return false;
+        }
+        size_t left = written;
+        while (left >= iov->iov_len) {
+            left -= iov->iov_len;
+            ++iov;
+            --count;
+            if (count == 0) {
+                return true;
+            }
+        }
+        iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+        iov->iov_len -= left;
+    }
+}
+
+}  // anonymous namespace
+
+namespace android {
+
+fd_filebuf::fd_filebuf(int fd, size_t buffer_size, bool owns_fd)
+    : mFd(fd), mOwnsFd(owns_fd), mBuffer(NULL), mBufferSize(0) {
+    set_buffer_size(buffer_size);
+}
+
+fd_filebuf::~fd_filebuf() {
+    close();
+    free(mBuffer);
+}
+
+bool fd_filebuf::set_buffer_size(size_t size) {
+    if (!FlushBuffer()) {
+        return false;
+    }
+    char_type *buffer = NULL;
+    if (size > 0) {
+        buffer = static_cast<char_type*>(malloc(size));
+        if (buffer == NULL) {
+            return false;
+        }
+    }
+    free(mBuffer);
+    mBuffer = buffer;
+    mBufferSize = size;
+    setp(mBuffer, mBuffer + size);
+    return true;
+}
+
+bool fd_filebuf::close() {
+    bool result = FlushBuffer();
+    if (mOwnsFd && mFd >= 0) {
+        result = ::close(mFd) == 0 && result;
+        mFd = -1;
+    }
+    return result;
+}
+
+bool fd_filebuf::FlushBuffer(const char_type *str, size_t num) {
+    struct iovec iov[2];
+    iov[0].iov_base = pbase();
+    iov[0].iov_len = pptr() - pbase();
+    iov[1].iov_base = const_cast<char_type*>(str);
+    iov[1].iov_len = num;
+    setp(mBuffer, mBuffer + mBufferSize);
+    if (iov[0].iov_len + iov[1].iov_len == 0) {
+        return true;
+    }
+    return mFd >= 0 && writeAll(mFd, iov, 2);
+}
+
+std::streamsize
+fd_filebuf::xsputn(const char_type* str, std::streamsize num) {
+    if (num <= 0) {
+        return 0;
+    }
+    if (num <= epptr() - pptr()) {
+        traits_type::copy(pptr(), str, num);
+        pbump(num);
+        return num;
+    }
+    return FlushBuffer(str, num) ? num : 0;
+}
+
+fd_filebuf::int_type fd_filebuf::overflow(int_type c) {
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+        return FlushBuffer() ? traits_type::not_eof(c) : traits_type::eof();
+    }
+    const char_type ch = traits_type::to_char(c);
+    if (pptr() == epptr()) {
+        if (!FlushBuffer(&ch, mBufferSize == 0 ? 1 : 0)) {
+            return traits_type::eof();
+        }
+        if (mBufferSize == 0) {
+            return c;
+        }
+    }
+    *pptr() = ch;
+    pbump(1);
+    return c;
+}
+
+int fd_filebuf::sync() {
+    return FlushBuffer() ? 0 : -1;
+}
+
+// fd_ofstream
+
+fd_ofstream::fd_ofstream(int fd, size_t buffer_size)
+    : mBuf(fd, buffer_size) {
+    this->init(&mBuf);
+}
+
+fd_ofstream::fd_ofstream(const char *path, bool append, size_t buffer_size)
+    : mBuf(open(path, O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC),
+                0666),
+           buffer_size, true) {
+    this->init(&mBuf);
+}
+
+fd_ofstream::~fd_ofstream() { }
+
+}  // namespace android
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include "fill_kernels.h"
+
+#if defined(__ARM_NEON__) || defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+// Runtime dispatch of the fill kernels used by std::fill, std::fill_n
+// and std::uninitialized_fill on arrays of 2 to 16 byte values. The
+// AVX2 and SSE2 versions are in fill_avx2.cpp and fill_sse2.cpp, the
+// NEON and portable ones below.
+
+namespace {
+using android::FillKernels;
+
+template<typename _T>
+void fillScalar(_T *first, size_t count, _T value) {
+    for (; count > 0; --count, ++first) {
+        *first = value;
+    }
+}
+
+void fill128Scalar(void *first, size_t count, const void *value) {
+    char *dst = static_cast<char*>(first);
+    for (; count > 0; --count, dst += 16) {
+        memcpy(dst, value, 16);
+    }
+}
+
+const FillKernels kScalarFillKernels = {
+    fillScalar<unsigned short>, fillScalar<unsigned int>,
+    fillScalar<unsigned long long>, fill128Scalar
+};
+
+#if defined(__ARM_NEON__) || defined(__aarch64__)
+// NEON has no non temporal store usable from C: stream is a plain
+// store.
+struct NeonOps {
+    typedef uint8x16_t vector_type;
+    static uint8x16_t splat(unsigned short v) {
+        return vreinterpretq_u8_u16(vdupq_n_u16(v));
+    }
+    static uint8x16_t splat(unsigned int v) {
+        return vreinterpretq_u8_u32(vdupq_n_u32(v));
+    }
+    static uint8x16_t splat(unsigned long long v) {
+        return vreinterpretq_u8_u64(vdupq_n_u64(v));
+    }
+    static uint8x16_t broadcast(const void *p) {
+        return vld1q_u8(static_cast<const uint8_t*>(p));
+    }
+    static void store(char *p, uint8x16_t v) {
+        vst1q_u8(reinterpret_cast<uint8_t*>(p), v);
+    }
+    static void storeu(char *p, uint8x16_t v) { store(p, v); }
+    static void stream(char *p, uint8x16_t v) { store(p, v); }
+    static void fence() { }
+};
+
+const FillKernels kNeonFillKernels = {
+    fillKernel<NeonOps, unsigned short>, fillKernel<NeonOps, unsigned int>,
+    fillKernel<NeonOps, unsigned long long>, fill128Kernel<NeonOps>
+};
+#endif
+
+const FillKernels& selectKernels() {
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return android::kAvx2FillKernels;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return android::kSse2FillKernels;
+    }
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+    return kNeonFillKernels;
+#endif
+    return kScalarFillKernels;
+}
+
+// The CPU is probed on the first call.
+const FillKernels& kernels() {
+    static const FillKernels& sKernels = selectKernels();
+    return sKernels;
+}
+
+}  // anonymous namespace
+
+namespace android {
+
+void fill16(unsigned short *first, size_t count, unsigned short value) {
+    kernels().fill16(first, count, value);
+}
+
+void fill32(unsigned int *first, size_t count, unsigned int value) {
+    kernels().fill32(first, count, value);
+}
+
+void fill64(unsigned long long *first, size_t count,
+            unsigned long long value) {
+    kernels().fill64(first, count, value);
+}
+
+void fill128(void *first, size_t count, const void *value) {
+    kernels().fill128(first, count, value);
+}
+
+}  // namespace android
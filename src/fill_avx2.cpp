@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+// AVX2 fill kernels, see fill_kernels.h. Only used if the CPU supports
+// AVX2.
+
+#if defined(__i386__) || defined(__x86_64__)
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+#include <immintrin.h>
+#include "fill_kernels.h"
+
+namespace {
+
+struct Avx2Ops {
+    typedef __m256i vector_type;
+    static __m256i splat(unsigned short v) {
+        return _mm256_set1_epi16(static_cast<short>(v));
+    }
+    static __m256i splat(unsigned int v) {
+        return _mm256_set1_epi32(static_cast<int>(v));
+    }
+    static __m256i splat(unsigned long long v) {
+        return _mm256_set1_epi64x(static_cast<long long>(v));
+    }
+    static __m256i broadcast(const void *p) {
+        return _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(static_cast<const __m128i*>(p)));
+    }
+    static void store(char *p, __m256i v) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    static void storeu(char *p, __m256i v) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    static void stream(char *p, __m256i v) {
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(p), v);
+    }
+    static void fence() { _mm_sfence(); }
+};
+
+}  // anonymous namespace
+
+namespace android {
+
+const FillKernels kAvx2FillKernels = {
+    fillKernel<Avx2Ops, unsigned short>, fillKernel<Avx2Ops, unsigned int>,
+    fillKernel<Avx2Ops, unsigned long long>, fill128Kernel<Avx2Ops>
+};
+
+}  // namespace android
+
+#pragma GCC pop_options
+
+#endif  // defined(__i386__) || defined(__x86_64__)
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ANDROID_ASTL_SRC_FILL_KERNELS_H__
+#define ANDROID_ASTL_SRC_FILL_KERNELS_H__
+
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+
+// Fill kernels shared by src/fill_sse2.cpp, src/fill_avx2.cpp and the
+// NEON version in src/fill.cpp.
+//
+// The kernels are templates parameterized by an _Ops struct which
+// wraps the intrinsics of one instruction set:
+//   vector_type     SIMD register type.
+//   splat(v)        Vector with v in every lane (2, 4 or 8 bytes).
+//   broadcast(p)    Vector made of copies of the 16 bytes at p.
+//   store(p, v)     Aligned store.
+//   storeu(p, v)    Unaligned store.
+//   stream(p, v)    Aligned non temporal store.
+//   fence()         Order the non temporal stores.
+//
+// As for the search kernels, the including file selects the
+// instruction set with '#pragma GCC target'.
+
+namespace android {
+
+// Entry points of one instruction set, picked at runtime by
+// src/fill.cpp.
+struct FillKernels {
+    void (*fill16)(unsigned short *, size_t, unsigned short);
+    void (*fill32)(unsigned int *, size_t, unsigned int);
+    void (*fill64)(unsigned long long *, size_t, unsigned long long);
+    void (*fill128)(void *, size_t, const void *);
+};
+
+extern const FillKernels kSse2FillKernels;
+extern const FillKernels kAvx2FillKernels;
+
+// Fills larger than this bypass the caches: they would evict
+// everything else and the data would not be read back from there
+// anyway.
+const size_t kNonTemporalBytes = 4 * 1024 * 1024;
+
+}  // namespace android
+
+namespace {
+
+// Fill [dst, dst + bytes) with copies of v, which holds the pattern
+// at dst's phase. size is the element size, bytes a multiple of it
+// not smaller than the vector. Inlined so the callers, which take no
+// vector argument, clear the upper halves of the AVX registers on
+// return (mixing them with SSE code is slow otherwise).
+template<typename _Ops>
+inline __attribute__((always_inline)) void fillBytes(char *dst, size_t bytes, typename _Ops::vector_type v,
+               size_t size) {
+    typedef typename _Ops::vector_type vector_type;
+    const ptrdiff_t kWidth = sizeof(vector_type);
+    char *const end = dst + bytes;
+
+    // Unaligned first and last vectors.
+    _Ops::storeu(dst, v);
+    _Ops::storeu(end - kWidth, v);
+    if (reinterpret_cast<uintptr_t>(dst) % size != 0) {
+        // The pattern would be out of phase at the aligned addresses.
+        for (char *p = dst + kWidth; p < end - kWidth; p += kWidth) {
+            _Ops::storeu(p, v);
+        }
+        return;
+    }
+    const uintptr_t mask = kWidth - 1;
+    char *p = reinterpret_cast<char*>(
+        (reinterpret_cast<uintptr_t>(dst) + kWidth) & ~mask);
+    if (bytes >= android::kNonTemporalBytes) {
+        for (; end - p >= 4 * kWidth; p += 4 * kWidth) {
+            _Ops::stream(p, v);
+            _Ops::stream(p + kWidth, v);
+            _Ops::stream(p + 2 * kWidth, v);
+            _Ops::stream(p + 3 * kWidth, v);
+        }
+        _Ops::fence();
+    }
+    for (; end - p >= 4 * kWidth; p += 4 * kWidth) {
+        _Ops::store(p, v);
+        _Ops::store(p + kWidth, v);
+        _Ops::store(p + 2 * kWidth, v);
+        _Ops::store(p + 3 * kWidth, v);
+    }
+    for (; end - p >= kWidth; p += kWidth) {
+        _Ops::store(p, v);
+    }
+}
+
+template<typename _Ops, typename _T>
+void fillKernel(_T *first, size_t count, _T value) {
+    if (count * sizeof(_T) < sizeof(typename _Ops::vector_type)) {
+        for (; count > 0; --count, ++first) {
+            *first = value;
+        }
+        return;
+    }
+    fillBytes<_Ops>(reinterpret_cast<char*>(first), count * sizeof(_T),
+                    _Ops::splat(value), sizeof(_T));
+}
+
+template<typename _Ops>
+void fill128Kernel(void *first, size_t count, const void *value) {
+    char *dst = static_cast<char*>(first);
+    if (count * 16 < sizeof(typename _Ops::vector_type)) {
+        for (; count > 0; --count, dst += 16) {
+            memcpy(dst, value, 16);
+        }
+        return;
+    }
+    fillBytes<_Ops>(dst, count * 16, _Ops::broadcast(value), 16);
+}
+
+}  // anonymous namespace
+
+#endif  // ANDROID_ASTL_SRC_FILL_KERNELS_H__
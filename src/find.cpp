@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <algorithm>
+#include "find_kernels.h"
+
+// Runtime dispatch of the search kernels used by std::find, std::count
+// and std::search on arrays of integers. The AVX2 and SSE2 versions
+// are in find_avx2.cpp and find_sse2.cpp, the portable one below.
+
+namespace {
+using android::FindKernels;
+
+template<typename _T>
+const _T *findScalar(const _T *first, const _T *last, _T value) {
+    for (; first != last; ++first) {
+        if (*first == value) {
+            break;
+        }
+    }
+    return first;
+}
+
+template<typename _T>
+size_t countScalar(const _T *first, const _T *last, _T value) {
+    size_t count = 0;
+    for (; first != last; ++first) {
+        count += *first == value;
+    }
+    return count;
+}
+
+const FindKernels kScalarFindKernels = {
+    findScalar<unsigned char>, findScalar<unsigned int>,
+    findScalar<unsigned long long>,
+    countScalar<unsigned char>, countScalar<unsigned int>,
+    countScalar<unsigned long long>
+};
+
+const FindKernels& selectKernels() {
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return android::kAvx2FindKernels;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return android::kSse2FindKernels;
+    }
+#endif
+    return kScalarFindKernels;
+}
+
+// The CPU is probed on the first call.
+const FindKernels& kernels() {
+    static const FindKernels& sKernels = selectKernels();
+    return sKernels;
+}
+
+}  // anonymous namespace
+
+namespace android {
+
+const unsigned char *find8(const unsigned char *first,
+                           const unsigned char *last, unsigned char value) {
+    return kernels().find8(first, last, value);
+}
+
+const unsigned int *find32(const unsigned int *first,
+                           const unsigned int *last, unsigned int value) {
+    return kernels().find32(first, last, value);
+}
+
+const unsigned long long *find64(const unsigned long long *first,
+                                 const unsigned long long *last,
+                                 unsigned long long value) {
+    return kernels().find64(first, last, value);
+}
+
+size_t count8(const unsigned char *first, const unsigned char *last,
+              unsigned char value) {
+    return kernels().count8(first, last, value);
+}
+
+size_t count32(const unsigned int *first, const unsigned int *last,
+               unsigned int value) {
+    return kernels().count32(first, last, value);
+}
+
+size_t count64(const unsigned long long *first,
+               const unsigned long long *last, unsigned long long value) {
+    return kernels().count64(first, last, value);
+}
+
+}  // namespace android
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+// AVX2 search kernels, see find_kernels.h. Only used if the CPU
+// supports AVX2.
+
+#if defined(__i386__) || defined(__x86_64__)
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+#include <immintrin.h>
+#include "find_kernels.h"
+
+namespace {
+
+struct Avx2Ops8 {
+    typedef unsigned char value_type;
+    typedef __m256i vector_type;
+    static __m256i splat(value_type v) {
+        return _mm256_set1_epi8(static_cast<char>(v));
+    }
+    static __m256i load(const value_type *p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static __m256i cmpeq(__m256i a, __m256i b) { return _mm256_cmpeq_epi8(a, b); }
+    static __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi8(a, b); }
+    static __m256i either(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+    static unsigned int movemask(__m256i a) { return _mm256_movemask_epi8(a); }
+};
+
+struct Avx2Ops32 {
+    typedef unsigned int value_type;
+    typedef __m256i vector_type;
+    static __m256i splat(value_type v) {
+        return _mm256_set1_epi32(static_cast<int>(v));
+    }
+    static __m256i load(const value_type *p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static __m256i cmpeq(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+    static __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi32(a, b); }
+    static __m256i either(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+    static unsigned int movemask(__m256i a) { return _mm256_movemask_epi8(a); }
+};
+
+struct Avx2Ops64 {
+    typedef unsigned long long value_type;
+    typedef __m256i vector_type;
+    static __m256i splat(value_type v) {
+        return _mm256_set1_epi64x(static_cast<long long>(v));
+    }
+    static __m256i load(const value_type *p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+    static __m256i cmpeq(__m256i a, __m256i b) { return _mm256_cmpeq_epi64(a, b); }
+    static __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi64(a, b); }
+    static __m256i either(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+    static unsigned int movemask(__m256i a) { return _mm256_movemask_epi8(a); }
+};
+
+}  // anonymous namespace
+
+namespace android {
+
+const FindKernels kAvx2FindKernels = {
+    findKernel<Avx2Ops8>, findKernel<Avx2Ops32>, findKernel<Avx2Ops64>,
+    countKernel<Avx2Ops8>, countKernel<Avx2Ops32>, countKernel<Avx2Ops64>
+};
+
+}  // namespace android
+
+#pragma GCC pop_options
+
+#endif  // defined(__i386__) || defined(__x86_64__)
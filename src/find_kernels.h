@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#ifndef ANDROID_ASTL_SRC_FIND_KERNELS_H__
+#define ANDROID_ASTL_SRC_FIND_KERNELS_H__
+
+#include <cstddef>
+#include <cstring>
+
+// Search kernels shared by src/find_sse2.cpp and src/find_avx2.cpp.
+//
+// The kernels are templates parameterized by an _Ops struct which
+// wraps the intrinsics of one instruction set for one element size:
+//   value_type     Unsigned element type.
+//   vector_type    SIMD register type.
+//   splat(v)       Vector with v in every lane.
+//   load(p)        Unaligned load.
+//   cmpeq(a, b)    All ones in the lanes where a and b are equal.
+//   sub(a, b)      Lane-wise a - b.
+//   either(a, b)   Bitwise or.
+//   movemask(a)    One bit per byte of a, from its high bit.
+//
+// The including file selects the instruction set with
+// '#pragma GCC target' before including this header. The templates
+// live in an anonymous namespace so each file gets its own copies
+// compiled for its instruction set.
+
+namespace android {
+
+// Entry points of one instruction set, picked at runtime by
+// src/find.cpp.
+struct FindKernels {
+    const unsigned char *(*find8)(const unsigned char *,
+                                  const unsigned char *, unsigned char);
+    const unsigned int *(*find32)(const unsigned int *,
+                                  const unsigned int *, unsigned int);
+    const unsigned long long *(*find64)(const unsigned long long *,
+                                        const unsigned long long *,
+                                        unsigned long long);
+    size_t (*count8)(const unsigned char *, const unsigned char *,
+                     unsigned char);
+    size_t (*count32)(const unsigned int *, const unsigned int *,
+                      unsigned int);
+    size_t (*count64)(const unsigned long long *,
+                      const unsigned long long *, unsigned long long);
+};
+
+extern const FindKernels kSse2FindKernels;
+extern const FindKernels kAvx2FindKernels;
+
+}  // namespace android
+
+namespace {
+
+template<typename _Ops>
+const typename _Ops::value_type *findKernel(
+    const typename _Ops::value_type *first,
+    const typename _Ops::value_type *last,
+    typename _Ops::value_type value) {
+    typedef typename _Ops::value_type value_type;
+    typedef typename _Ops::vector_type vector_type;
+    const ptrdiff_t kLanes = sizeof(vector_type) / sizeof(value_type);
+    const vector_type needle = _Ops::splat(value);
+
+    // Two vectors per iteration, the match is located once found.
+    while (last - first >= 2 * kLanes) {
+        const vector_type a = _Ops::cmpeq(_Ops::load(first), needle);
+        const vector_type b = _Ops::cmpeq(_Ops::load(first + kLanes), needle);
+        if (_Ops::movemask(_Ops::either(a, b)) != 0) {
+            const unsigned int mask_a = _Ops::movemask(a);
+            if (mask_a != 0) {
+                return first + __builtin_ctz(mask_a) / sizeof(value_type);
+            }
+            return first + kLanes +
+                    __builtin_ctz(_Ops::movemask(b)) / sizeof(value_type);
+        }
+        first += 2 * kLanes;
+    }
+    if (last - first >= kLanes) {
+        const unsigned int mask =
+                _Ops::movemask(_Ops::cmpeq(_Ops::load(first), needle));
+        if (mask != 0) {
+            return first + __builtin_ctz(mask) / sizeof(value_type);
+        }
+        first += kLanes;
+    }
+    for (; first != last; ++first) {
+        if (*first == value) {
+            break;
+        }
+    }
+    return first;
+}
+
+template<typename _Ops>
+size_t countKernel(const typename _Ops::value_type *first,
+                   const typename _Ops::value_type *last,
+                   typename _Ops::value_type value) {
+    typedef typename _Ops::value_type value_type;
+    typedef typename _Ops::vector_type vector_type;
+    const ptrdiff_t kLanes = sizeof(vector_type) / sizeof(value_type);
+    // The per lane counters are flushed before they can overflow
+    // (255 for bytes).
+    const ptrdiff_t kMaxIterations = 255;
+    const vector_type needle = _Ops::splat(value);
+    const vector_type zero = _Ops::splat(0);
+    size_t count = 0;
+
+    while (last - first >= kLanes) {
+        ptrdiff_t iterations = (last - first) / kLanes;
+        if (iterations > kMaxIterations) {
+            iterations = kMaxIterations;
+        }
+        // A match is all ones (-1): subtracting it adds 1.
+        vector_type counters = zero;
+        for (; iterations > 0; --iterations, first += kLanes) {
+            counters = _Ops::sub(counters,
+                                 _Ops::cmpeq(_Ops::load(first), needle));
+        }
+        value_type lanes[kLanes];
+        memcpy(lanes, &counters, sizeof(lanes));
+        for (ptrdiff_t i = 0; i < kLanes; ++i) {
+            count += lanes[i];
+        }
+    }
+    for (; first != last; ++first) {
+        count += *first == value;
+    }
+    return count;
+}
+
+}  // anonymous namespace
+
+#endif  // ANDROID_ASTL_SRC_FIND_KERNELS_H__
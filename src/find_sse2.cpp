@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+// SSE2 search kernels, see find_kernels.h. SSE2 is always available
+// on x86-64; on x86 the kernels are only used if the CPU supports it.
+
+#if defined(__i386__) || defined(__x86_64__)
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+
+#include <emmintrin.h>
+#include "find_kernels.h"
+
+namespace {
+
+struct Sse2Ops8 {
+    typedef unsigned char value_type;
+    typedef __m128i vector_type;
+    static __m128i splat(value_type v) {
+        return _mm_set1_epi8(static_cast<char>(v));
+    }
+    static __m128i load(const value_type *p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+    static __m128i cmpeq(__m128i a, __m128i b) { return _mm_cmpeq_epi8(a, b); }
+    static __m128i sub(__m128i a, __m128i b) { return _mm_sub_epi8(a, b); }
+    static __m128i either(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+    static unsigned int movemask(__m128i a) { return _mm_movemask_epi8(a); }
+};
+
+struct Sse2Ops32 {
+    typedef unsigned int value_type;
+    typedef __m128i vector_type;
+    static __m128i splat(value_type v) {
+        return _mm_set1_epi32(static_cast<int>(v));
+    }
+    static __m128i load(const value_type *p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+    static __m128i cmpeq(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+    static __m128i sub(__m128i a, __m128i b) { return _mm_sub_epi32(a, b); }
+    static __m128i either(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+    static unsigned int movemask(__m128i a) { return _mm_movemask_epi8(a); }
+};
+
+struct Sse2Ops64 {
+    typedef unsigned long long value_type;
+    typedef __m128i vector_type;
+    static __m128i splat(value_type v) {
+        return _mm_set1_epi64x(static_cast<long long>(v));
+    }
+    static __m128i load(const value_type *p) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    }
+    // No 64 bit compare in SSE2: both 32 bit halves must be equal.
+    static __m128i cmpeq(__m128i a, __m128i b) {
+        const __m128i eq = _mm_cmpeq_epi32(a, b);
+        return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+    }
+    static __m128i sub(__m128i a, __m128i b) { return _mm_sub_epi64(a, b); }
+    static __m128i either(__m128i a, __m128i b) { return _mm_or_si128(a, b); }
+    static unsigned int movemask(__m128i a) { return _mm_movemask_epi8(a); }
+};
+
+}  // anonymous namespace
+
+namespace android {
+
+const FindKernels kSse2FindKernels = {
+    findKernel<Sse2Ops8>, findKernel<Sse2Ops32>, findKernel<Sse2Ops64>,
+    countKernel<Sse2Ops8>, countKernel<Sse2Ops32>, countKernel<Sse2Ops64>
+};
+
+}  // namespace android
+
+#pragma GCC pop_options
+
+#endif  // defined(__i386__) || defined(__x86_64__)
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+
+#include <functional>
+#include <cstring>
+#include <string>
+#include <stdint.h>
+
+// Fast non cryptographic hash of a byte array, after wyhash (public
+// domain, Wang Yi). The input is consumed 8 bytes at a time (16 or 48
+// per iteration) and each step is a 64x64 -> 128 bit multiply whose
+// halves are folded together. Short keys (<= 16 bytes) are read with
+// at most 4 overlapping loads, without any loop.
+//
+// The result depends on the byte order and on the size of size_t (the
+// 64 bit hash is truncated): it must not be persisted.
+
+namespace {
+
+const uint64_t kSecret0 = 0xa0761d6478bd642fULL;
+const uint64_t kSecret1 = 0xe7037ed1a0b428dbULL;
+const uint64_t kSecret2 = 0x8ebc6af09c88c6e3ULL;
+const uint64_t kSecret3 = 0x589965cc75374cc3ULL;
+
+// Multiply a and b, store the low half of the product in a and the
+// high half in b.
+inline void multiply(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    const __uint128_t r = static_cast<__uint128_t>(*a) * *b;
+    *a = static_cast<uint64_t>(r);
+    *b = static_cast<uint64_t>(r >> 64);
+#else
+    // 32 bit targets: schoolbook multiplication on 32 bit halves.
+    const uint64_t ha = *a >> 32, hb = *b >> 32;
+    const uint64_t la = static_cast<uint32_t>(*a), lb = static_cast<uint32_t>(*b);
+    const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const uint64_t t = rl + (rm0 << 32);
+    uint64_t carry = t < rl;
+    const uint64_t lo = t + (rm1 << 32);
+    carry += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+inline uint64_t mix(uint64_t a, uint64_t b) {
+    multiply(&a, &b);
+    return a ^ b;
+}
+
+// Unaligned loads, memcpy compiles to a single instruction.
+inline uint64_t read8(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint64_t read4(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+// 1 to 3 bytes: first, middle and last.
+inline uint64_t read3(const unsigned char *p, size_t len) {
+    return (static_cast<uint64_t>(p[0]) << 16) |
+            (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+}
+
+}  // anonymous namespace
+
+namespace android {
+
+size_t hash_bytes(const void *data, size_t len) {
+    const unsigned char *p = static_cast<const unsigned char*>(data);
+    uint64_t seed = mix(kSecret0, kSecret1);
+    uint64_t a, b;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            // 2 pairs of possibly overlapping 4 byte words.
+            const size_t offset = (len >> 3) << 2;
+            a = (read4(p) << 32) | read4(p + offset);
+            b = (read4(p + len - 4) << 32) | read4(p + len - 4 - offset);
+        } else if (len > 0) {
+            a = read3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t remaining = len;
+        if (remaining > 48) {
+            // 3 independent lanes to hide the multiply latency.
+            uint64_t seed1 = seed, seed2 = seed;
+            do {
+                seed = mix(read8(p) ^ kSecret1, read8(p + 8) ^ seed);
+                seed1 = mix(read8(p + 16) ^ kSecret2, read8(p + 24) ^ seed1);
+                seed2 = mix(read8(p + 32) ^ kSecret3, read8(p + 40) ^ seed2);
+                p += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (remaining > 16) {
+            seed = mix(read8(p) ^ kSecret1, read8(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        // Last 16 bytes, may overlap the ones already consumed.
+        a = read8(p + remaining - 16);
+        b = read8(p + remaining - 8);
+    }
+    a ^= kSecret1;
+    b ^= seed;
+    multiply(&a, &b);
+    return static_cast<size_t>(mix(a ^ kSecret0 ^ len, b ^ kSecret1));
+}
+
+}  // namespace android
+
+namespace std {
+
+size_t hash<string>::operator()(const string& str) const {
+    return android::hash_bytes(str.data(), str.size());
+}
+
+size_t hash<const char*>::operator()(const char *str) const {
+    return android::hash_bytes(str, strlen(str));
+}
+
+}  // namespace std
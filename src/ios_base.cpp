@@ -57,7 +57,7 @@ ios_base::fmtflags ios_base::flags(fmtflags flags) {
 
 ios_base::fmtflags ios_base::setf(fmtflags flags) {
     fmtflags prev = mFlags;
-    mFlags = flags;
+    mFlags |= flags;
     return prev;
 }
 
@@ -108,7 +108,8 @@ ios_base::Init::Init() {
             // structures. stdio_filebuf_cout/stdio_filebuf_cerr and
             // cout/cerr storage are in ios_globals.cpp.
             new (&stdio_filebuf_cout) android::stdio_filebuf(stdout);
-            new (&stdio_filebuf_cerr) android::stdio_filebuf(stderr);
+            // cerr is unbuffered.
+            new (&stdio_filebuf_cerr) android::stdio_filebuf(stderr, false);
             new (&cout) ostream(&stdio_filebuf_cout);
             new (&cerr) ostream(&stdio_filebuf_cerr);
             sDone = true;
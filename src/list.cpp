@@ -27,6 +27,7 @@
  */
 
 #include <list>
+#include <cstdlib>
 
 namespace android {
 
@@ -68,4 +69,120 @@ void ListNodeBase::unhook() {
     next->mPrev = prev;
 }
 
+void ListNodeBase::transfer(ListNodeBase *pos, ListNodeBase *first,
+                            ListNodeBase *last) {
+    if (first == last || pos == last) {
+        return;
+    }
+    ListNodeBase *const tail = last->mPrev;
+    // Unlink [first, tail] from its list.
+    first->mPrev->mNext = last;
+    last->mPrev = first->mPrev;
+    // Link it before pos.
+    first->mPrev = pos->mPrev;
+    tail->mNext = pos;
+    pos->mPrev->mNext = first;
+    pos->mPrev = tail;
+}
+
+void ListNodeBase::reverse(ListNodeBase *head) {
+    ListNodeBase *node = head;
+    do {
+        std::swap(node->mNext, node->mPrev);
+        node = node->mPrev;  // The old next.
+    } while (node != head);
+}
+
+ListNodePool::ListNodePool(size_t node_size)
+        : mFree(NULL), mChunks(NULL), mCursor(NULL), mEnd(NULL),
+          mChunkNodes(kMinChunkNodes), mId(0), mShared(false) {
+    // Append the chunk pointer, keep the nodes aligned like a
+    // malloc'ed block.
+    const size_t align = 2 * sizeof(void*);
+    mNodeSize = (node_size + sizeof(Chunk*) + align - 1) & ~(align - 1);
+}
+
+void ListNodePool::release() {
+    if (!mShared) {
+        // All the nodes are ours and none is used.
+        while (mChunks != NULL) {
+            Chunk *const next = mChunks->mNext;
+            free(mChunks);
+            mChunks = next;
+        }
+    } else {
+        // Count the nodes we got back, drop them and our reference.
+        for (Chunk *chunk = mChunks; chunk != NULL; chunk = chunk->mNext) {
+            chunk->mUnused = 0;
+        }
+        for (FreeNode *node = mFree; node != NULL; node = node->mNext) {
+            ++chunkOf(node)->mUnused;
+        }
+        if (mChunks != NULL) {
+            mChunks->mUnused += (mEnd - mCursor) / mNodeSize;
+        }
+        while (mChunks != NULL) {
+            Chunk *const chunk = mChunks;
+            mChunks = chunk->mNext;
+            if (__sync_sub_and_fetch(&chunk->mRefs, chunk->mUnused + 1) == 0) {
+                free(chunk);
+            }
+        }
+        // The chunks still alive must not take our new nodes.
+        mId = 0;
+        mShared = false;
+    }
+    mFree = NULL;
+    mCursor = mEnd = NULL;
+    mChunkNodes = kMinChunkNodes;
+}
+
+size_t ListNodePool::newId() {
+    static volatile size_t sLastId = 0;
+    return __sync_add_and_fetch(&sLastId, 1);
+}
+
+void ListNodePool::unrefChunk(Chunk *chunk) {
+    if (__sync_sub_and_fetch(&chunk->mRefs, 1) == 0) {
+        free(chunk);  // The owner released it before.
+    }
+}
+
+size_t ListNodePool::chunkCount() const {
+    size_t count = 0;
+    for (const Chunk *chunk = mChunks; chunk != NULL; chunk = chunk->mNext) {
+        ++count;
+    }
+    return count;
+}
+
+bool ListNodePool::allocateChunk() {
+    // Start small for short lists, double the chunk size as the list
+    // grows to keep the number of mallocs logarithmic.
+    size_t nodes = mChunkNodes;
+    if (nodes > 1 && nodes * mNodeSize > kMaxChunkBytes) {
+        nodes = kMaxChunkBytes / mNodeSize;
+        if (nodes == 0) {
+            nodes = 1;
+        }
+    } else {
+        mChunkNodes *= 2;
+    }
+    Chunk *const chunk = static_cast<Chunk*>(
+        malloc(kChunkHeaderSize + nodes * mNodeSize));
+    if (chunk == NULL) {
+        return false;
+    }
+    if (mId == 0) {
+        mId = newId();
+    }
+    chunk->mNext = mChunks;
+    chunk->mOwner = mId;
+    chunk->mRefs = nodes + 1;
+    mChunks = chunk;
+    mCursor = reinterpret_cast<char*>(chunk) + kChunkHeaderSize;
+    mEnd = mCursor + nodes * mNodeSize;
+    return true;
+}
+
 }  // namespace android
@@ -28,8 +28,11 @@
 
 #include <ostream>
 #include <streambuf>
+#include <cstdlib>
 #include <cstring>
 #include <limits>
+#include <stdint.h>
+#include "float_to_decimal.h"
 
 namespace std {
 // Defined in bionic/libstdc++/src/one_time_construction.cpp
@@ -45,11 +48,6 @@ ostream& ostream::operator<<(const char_type *str) {
     return *this;
 }
 
-ostream& ostream::operator<<(char_type c) {
-    // TODO: Should format according to flags.
-    return put(c);
-}
-
 ostream& ostream::operator<<(bool val) {
     // TODO: Should format according to flags (e.g write "true" or "false").
     return put(val?'1':'0');
@@ -59,61 +57,551 @@ ostream& ostream::operator<<(bool val) {
 // for the format specifier + 1 for the terminating \0. A total of 26
 // chars should be enough to hold any integer representation.
 static const size_t kNumSize = 26;
-ostream& ostream::operator<<(int val) {
-    const char *fmt = "%d";
+
+namespace {
+
+// "00" to "99": decimal numbers are converted two digits at a time.
+const char kDigitPairs[] =
+        "00010203040506070809101112131415161718192021222324252627282930"
+        "31323334353637383940414243444546474849505152535455565758596061"
+        "62636465666768697071727374757677787980818283848586878889909192"
+        "93949596979899";
+const char kHexDigits[] = "0123456789abcdef0123456789ABCDEF";
+
+// The format* functions write the digits of val backward, the last
+// one at end[-1].
+// @return A pointer to the first digit.
+template<typename _Unsigned>
+char *formatDec(_Unsigned val, char *end) {
+    while (val >= 100) {
+        const unsigned pair = static_cast<unsigned>(val % 100) * 2;
+        val /= 100;
+        end -= 2;
+        end[0] = kDigitPairs[pair];
+        end[1] = kDigitPairs[pair + 1];
+    }
+    if (val >= 10) {
+        const unsigned pair = static_cast<unsigned>(val) * 2;
+        end -= 2;
+        end[0] = kDigitPairs[pair];
+        end[1] = kDigitPairs[pair + 1];
+    } else {
+        *--end = '0' + static_cast<char>(val);
+    }
+    return end;
+}
+
+template<typename _Unsigned>
+char *formatOct(_Unsigned val, char *end) {
+    do {
+        *--end = '0' + static_cast<char>(val & 7);
+        val >>= 3;
+    } while (val != 0);
+    return end;
+}
+
+template<typename _Unsigned>
+char *formatHex(_Unsigned val, char *end, bool uppercase) {
+    const char *const digits = uppercase ? kHexDigits + 16 : kHexDigits;
+    do {
+        *--end = digits[val & 15];
+        val >>= 4;
+    } while (val != 0);
+    return end;
+}
+
+void pad(streambuf *sb, char fill, streamsize num) {
+    for (; num > 0; --num) {
+        sb->sputc(fill);
+    }
+}
+
+// Write [begin, end) padded to width() with fill() as required by the
+// adjustfield flags. width() is reset to 0.
+// @param prefix Length of the sign or base prefix after which the
+// internal padding goes.
+ostream& writePadded(ostream& os, const char *begin, const char *end,
+                     size_t prefix) {
+    streambuf *const sb = os.rdbuf();
+    const streamsize padding = os.width() - (end - begin);
+    os.width(0);
+    if (sb == NULL) {
+        return os;
+    }
+    if (padding <= 0) {
+        sb->sputn(begin, end - begin);
+        return os;
+    }
+    const ios_base::fmtflags adjust = os.flags() & ios_base::adjustfield;
+    if (adjust == ios_base::left) {
+        sb->sputn(begin, end - begin);
+        pad(sb, os.fill(), padding);
+    } else if (adjust == ios_base::internal) {
+        sb->sputn(begin, prefix);
+        pad(sb, os.fill(), padding);
+        sb->sputn(begin + prefix, end - begin - prefix);
+    } else {
+        pad(sb, os.fill(), padding);
+        sb->sputn(begin, end - begin);
+    }
+    return os;
+}
+
+// Write val according to the basefield, showbase, showpos and
+// uppercase flags, padded as writePadded does.
+// @param val Magnitude of the value to print.
+// @param negative True if val is the magnitude of a negative number.
+// @param is_signed True if the value has a signed type. Only signed
+// values are printed with a sign and only in decimal.
+template<typename _Unsigned>
+ostream& writeInteger(ostream& os, _Unsigned val, bool negative,
+                      bool is_signed) {
+    const ios_base::fmtflags flags = os.flags();
+    const ios_base::fmtflags base = flags & ios_base::basefield;
     char buf[kNumSize];
-    int size = snprintf(buf, kNumSize, fmt, val);
-    return write(buf, size);
+    char *const end = buf + kNumSize;
+    char *begin;
+
+    // Number of characters before the digits: sign or base prefix.
+    size_t prefix = 0;
+    if (base == ios_base::hex) {
+        const bool uppercase = (flags & ios_base::uppercase) != 0;
+        begin = formatHex(val, end, uppercase);
+        if ((flags & ios_base::showbase) && val != 0) {
+            *--begin = uppercase ? 'X' : 'x';
+            *--begin = '0';
+            prefix = 2;
+        }
+    } else if (base == ios_base::oct) {
+        begin = formatOct(val, end);
+        if ((flags & ios_base::showbase) && val != 0) {
+            *--begin = '0';
+        }
+    } else {
+        begin = formatDec(val, end);
+        if (negative) {
+            *--begin = '-';
+            prefix = 1;
+        } else if (is_signed && (flags & ios_base::showpos)) {
+            *--begin = '+';
+            prefix = 1;
+        }
+    }
+
+    return writePadded(os, begin, end, prefix);
 }
 
-ostream& ostream::operator<<(unsigned int val) {
-    const char *fmt = "%u";
+// In decimal, negative values are printed as '-' and their
+// magnitude. In octal and hexadecimal, they are printed as their
+// unsigned two's complement representation like printf does.
+template<typename _Signed, typename _Unsigned>
+ostream& writeSigned(ostream& os, _Signed val) {
+    const _Unsigned uval = static_cast<_Unsigned>(val);
+    if (val < 0 && (os.flags() & ios_base::basefield) != ios_base::oct &&
+        (os.flags() & ios_base::basefield) != ios_base::hex) {
+        return writeInteger(os, static_cast<_Unsigned>(0 - uval), true, true);
+    }
+    return writeInteger(os, uval, false, true);
+}
+
+// Floating point output.
+//
+// The value is first converted to its shortest round trip decimal
+// (see src/float_to_decimal.h). The output must be the one of printf
+// though: the value rounded to the number of digits the flags ask
+// for. That decimal gives it directly when:
+// - it has more digits than needed, and the digits dropped are not
+//   exactly a half (which could be rounded either way). Any rounding
+//   boundary between the value and the decimal would be a shorter or
+//   closer decimal reading back as the value.
+// - it has at most kDigits digits and the value is normal. These
+//   digits followed by zeros are the value rounded to any count up
+//   to kDigits (DBL_DIG, FLT_DIG).
+// - it is the exact value.
+// Otherwise, or if the output does not fit kFloatSize, a float is
+// printed as a double, as ostream does in the standard, and a
+// double with snprintf.
+
+const size_t kFloatSize = 64;
+
+const uint64_t kPow10[] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+    100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL,
+    10000000000000000000ULL
+};
+
+// kDigits:          DBL_DIG, FLT_DIG.
+// kMaxDigits:       Digits of the longest shortest decimal.
+// kMaxFractionBits: Fraction bits of the most precise value whose
+//                   shortest decimal can be exact.
+template<typename _Float> struct FloatTraits;
+
+template<> struct FloatTraits<double> {
+    typedef uint64_t bits_type;
+    static const int kMantissaBits = 52;
+    static const int kBias = 1023;
+    static const int kDigits = 15;
+    static const int kMaxDigits = 17;
+    static const int kMaxFractionBits = 24;  // 5^25 > 10^17
+};
+
+template<> struct FloatTraits<float> {
+    typedef uint32_t bits_type;
+    static const int kMantissaBits = 23;
+    static const int kBias = 127;
+    static const int kDigits = 6;
+    static const int kMaxDigits = 9;
+    static const int kMaxFractionBits = 12;  // 5^13 > 10^9
+};
+
+int digitCount(uint64_t val) {
+    int count = 1;
+    while (count < 20 && val >= kPow10[count]) {
+        ++count;
+    }
+    return count;
+}
+
+// @return true if m * 2^e == digits * 10^exponent for some integer
+// digits, i.e. m * 2^(e - exponent) * 5^-exponent is an integer.
+bool isMultipleOfPow10(uint64_t m, int e, int exponent) {
+    if (exponent > 0) {
+        if (exponent >= 23) {
+            return false;  // m < 2^53 < 5^23
+        }
+        uint64_t pow5 = 1;
+        for (int i = 0; i < exponent; ++i) {
+            pow5 *= 5;
+        }
+        if (m % pow5 != 0) {
+            return false;
+        }
+    }
+    return e >= exponent || __builtin_ctzll(m) >= exponent - e;
+}
+
+// Round dec, made of len digits, to keep significant digits. keep may
+// be <= 0 (fixed notation), the result is then 0 or 1 unit of the
+// last kept position.
+// @param exact True if dec is the exact value: halves round to even.
+// @return false if the rounding direction cannot be known.
+bool roundDecimal(android::Decimal *dec, int len, long keep, bool exact) {
+    if (keep < 0) {
+        dec->digits = 0;
+        dec->exponent += len - keep;
+        return true;
+    }
+    const uint64_t div = kPow10[len - keep];
+    const uint64_t half = div / 2;
+    uint64_t digits = dec->digits / div;
+    const uint64_t rem = dec->digits % div;
+    if (rem == half && !exact) {
+        return false;
+    }
+    if (rem > half || (rem == half && digits % 2 == 1)) {
+        ++digits;
+    }
+    dec->digits = digits;
+    dec->exponent += len - keep;
+    return true;
+}
+
+char *fillChars(char *out, char c, long num) {
+    for (; num > 0; --num) {
+        *out++ = c;
+    }
+    return out;
+}
+
+// Write 'digits' * 10^exponent in [-]d.ddde[+-]xx notation with
+// precision digits after the point.
+char *formatScientific(char *out, uint64_t digits, int exponent,
+                       long precision, bool showpoint, bool uppercase) {
     char buf[kNumSize];
-    int size = snprintf(buf, kNumSize, fmt, val);
-    return write(buf, size);
+    char *const end = buf + kNumSize;
+    const char *begin = formatDec(digits, end);
+    const int len = end - begin;
+    int exp10 = digits == 0 ? 0 : exponent + len - 1;
+
+    *out++ = *begin++;
+    if (precision > 0 || showpoint) {
+        *out++ = '.';
+    }
+    while (begin < end) {
+        *out++ = *begin++;
+    }
+    out = fillChars(out, '0', precision - (len - 1));
+    *out++ = uppercase ? 'E' : 'e';
+    if (exp10 < 0) {
+        *out++ = '-';
+        exp10 = -exp10;
+    } else {
+        *out++ = '+';
+    }
+    if (exp10 < 10) {
+        *out++ = '0';
+    }
+    begin = formatDec(static_cast<unsigned>(exp10), end);
+    while (begin < end) {
+        *out++ = *begin++;
+    }
+    return out;
 }
 
-ostream& ostream::operator<<(long int val) {
-    const char *fmt = "%ld";
+// Write 'digits' * 10^exponent in [-]ddd.ddd notation with precision
+// digits after the point, precision >= -exponent.
+char *formatFixed(char *out, uint64_t digits, int exponent, long precision,
+                  bool showpoint) {
     char buf[kNumSize];
-    int size = snprintf(buf, kNumSize, fmt, val);
-    return write(buf, size);
+    char *const end = buf + kNumSize;
+    const char *begin = formatDec(digits, end);
+    const int len = end - begin;
+    const int int_digits = len + exponent;
+    const bool point = precision > 0 || showpoint;
+
+    long fraction = 0;
+    if (int_digits <= 0) {
+        *out++ = '0';
+        if (point) {
+            *out++ = '.';
+        }
+        out = fillChars(out, '0', -int_digits);
+        fraction = -int_digits;
+    } else if (int_digits >= len) {
+        while (begin < end) {
+            *out++ = *begin++;
+        }
+        out = fillChars(out, '0', int_digits - len);
+        if (point) {
+            *out++ = '.';
+        }
+    } else {
+        for (int i = 0; i < int_digits; ++i) {
+            *out++ = *begin++;
+        }
+        *out++ = '.';
+    }
+    fraction += end - begin;
+    while (begin < end) {
+        *out++ = *begin++;
+    }
+    return fillChars(out, '0', precision - fraction);
+}
+
+// Format val like snprintf does with the conversion the flags select
+// (%f, %e or %g, + and # flags). The output is allocated on the heap
+// when it does not fit in a buffer of kFloatSize.
+ostream& writeWithPrintf(ostream& os, double val) {
+    const ios_base::fmtflags flags = os.flags();
+    const ios_base::fmtflags field = flags & ios_base::floatfield;
+    const bool uppercase = (flags & ios_base::uppercase) != 0;
+    char fmt[8];
+    char *f = fmt;
+    *f++ = '%';
+    if (flags & ios_base::showpos) {
+        *f++ = '+';
+    }
+    if (flags & ios_base::showpoint) {
+        *f++ = '#';
+    }
+    *f++ = '.';
+    *f++ = '*';
+    *f++ = field == ios_base::fixed ? 'f' :
+            field == ios_base::scientific ? (uppercase ? 'E' : 'e') :
+            (uppercase ? 'G' : 'g');
+    *f = '\0';
+
+    const int precision = static_cast<int>(os.precision());
+    char buf[kFloatSize];
+    char *out = buf;
+    const int len = snprintf(buf, kFloatSize, fmt, precision, val);
+    if (len < 0) {
+        return os;
+    }
+    if (static_cast<size_t>(len) >= kFloatSize) {
+        out = static_cast<char *>(malloc(len + 1));
+        if (out == NULL) {
+            return os;
+        }
+        snprintf(out, len + 1, fmt, precision, val);
+    }
+    writePadded(os, out, out + len, out[0] == '-' || out[0] == '+');
+    if (out != buf) {
+        free(out);
+    }
+    return os;
+}
+
+template<typename _Float>
+ostream& writeFloat(ostream& os, _Float val);
+
+// Called when the shortest decimal is not enough.
+ostream& writeFallback(ostream& os, float val) {
+    return writeFloat(os, static_cast<double>(val));
+}
+
+ostream& writeFallback(ostream& os, double val) {
+    return writeWithPrintf(os, val);
+}
+
+template<typename _Float>
+ostream& writeFloat(ostream& os, _Float val) {
+    typedef FloatTraits<_Float> traits;
+    typedef typename traits::bits_type bits_type;
+
+    const ios_base::fmtflags flags = os.flags();
+    const bool uppercase = (flags & ios_base::uppercase) != 0;
+    const bool showpoint = (flags & ios_base::showpoint) != 0;
+    char buf[kFloatSize];
+    char *out = buf;
+
+    bits_type bits;
+    memcpy(&bits, &val, sizeof(bits));
+    const bits_type mantissa = bits & ((static_cast<bits_type>(1) <<
+                                        traits::kMantissaBits) - 1);
+    const int biased = static_cast<int>((bits << 1) >>
+                                        (traits::kMantissaBits + 1));
+    const int kMaxBiased = 2 * traits::kBias + 1;
+
+    if (bits >> (sizeof(bits) * 8 - 1)) {
+        *out++ = '-';
+    } else if (flags & ios_base::showpos) {
+        *out++ = '+';
+    }
+    const size_t prefix = out - buf;
+    if (biased == kMaxBiased) {
+        const char *str = mantissa != 0 ? (uppercase ? "NAN" : "nan") :
+                (uppercase ? "INF" : "inf");
+        memcpy(out, str, 3);
+        return writePadded(os, buf, out + 3, prefix);
+    }
+
+    // Number of significant digits to print, fixed needs the decimal
+    // exponent.
+    const ios_base::fmtflags field = flags & ios_base::floatfield;
+    const long precision = os.precision();
+    long keep;
+    if (field == ios_base::scientific) {
+        keep = precision + 1;
+    } else {
+        keep = precision == 0 ? 1 : precision;
+    }
+
+    android::Decimal dec;
+    bool exact = true;
+    const bool normal = biased != 0;
+    if (biased == 0 && mantissa == 0) {
+        dec.digits = 0;
+        dec.exponent = 0;
+    } else {
+        const uint64_t m = normal ?
+                mantissa | (static_cast<bits_type>(1) << traits::kMantissaBits) :
+                mantissa;
+        const int e = (normal ? biased : 1) - traits::kBias -
+                traits::kMantissaBits;
+        // With kMaxDigits or more digits to print, the shortest
+        // decimal is only useful if it is exact. An exact decimal has
+        // as many fraction digits as val has fraction bits, its
+        // digits are then a multiple of 5^bits.
+        if (field != ios_base::fixed && keep >= traits::kMaxDigits &&
+            -(e + __builtin_ctzll(m)) > traits::kMaxFractionBits) {
+            return writeFallback(os, val);
+        }
+        dec = android::shortestDecimal(val < 0 ? -val : val);
+        exact = isMultipleOfPow10(m, e, dec.exponent);
+    }
+
+    int len = digitCount(dec.digits);
+    if (field == ios_base::fixed) {
+        keep = dec.exponent + len + precision;
+    }
+
+    if (keep < len) {
+        if (!roundDecimal(&dec, len, keep, exact)) {
+            return writeFallback(os, val);
+        }
+        len = digitCount(dec.digits);
+        if (len > keep && keep > 0 && field != ios_base::fixed) {
+            // Rounded up to the next power of 10.
+            dec.digits /= 10;
+            ++dec.exponent;
+            --len;
+        }
+    } else if (!exact && (!normal || keep > traits::kDigits)) {
+        return writeFallback(os, val);
+    }
+
+    bool scientific = field == ios_base::scientific;
+    long digits_after = precision;
+    if (field != ios_base::fixed && field != ios_base::scientific) {
+        // %g: scientific if the exponent is < -4 or >= precision.
+        const long exp10 = dec.digits == 0 ? 0 : dec.exponent + len - 1;
+        scientific = exp10 < -4 || exp10 >= keep;
+        digits_after = scientific ? keep - 1 : keep - 1 - exp10;
+        if (!showpoint) {
+            // The trailing zeros are removed.
+            while (dec.digits != 0 && dec.digits % 10 == 0) {
+                dec.digits /= 10;
+                ++dec.exponent;
+                --len;
+            }
+            digits_after = scientific ? len - 1 :
+                    (dec.exponent < 0 ? -dec.exponent : 0);
+        }
+    }
+
+    // sign, digits, point, fraction and 'e-308'.
+    const long int_digits = dec.digits == 0 ? 1 : len + dec.exponent;
+    const long size = prefix + 1 + digits_after + 5 +
+            (scientific || int_digits < 1 ? 1 : int_digits);
+    if (size > static_cast<long>(kFloatSize)) {
+        return writeFallback(os, val);
+    }
+    if (scientific) {
+        out = formatScientific(out, dec.digits, dec.exponent, digits_after,
+                               showpoint, uppercase);
+    } else {
+        out = formatFixed(out, dec.digits, dec.exponent, digits_after,
+                          showpoint);
+    }
+    return writePadded(os, buf, out, prefix);
+}
+
+}  // anonymous namespace
+
+ostream& ostream::operator<<(int val) {
+    return writeSigned<int, unsigned int>(*this, val);
+}
+
+ostream& ostream::operator<<(unsigned int val) {
+    return writeInteger(*this, val, false, false);
+}
+
+ostream& ostream::operator<<(long int val) {
+    return writeSigned<long int, unsigned long int>(*this, val);
 }
 
 ostream& ostream::operator<<(unsigned long int val) {
-    const char *fmt = "%lu";
-    char buf[kNumSize];
-    int size = snprintf(buf, kNumSize, fmt, val);
-    return write(buf, size);
+    return writeInteger(*this, val, false, false);
 }
 
 ostream& ostream::operator<<(long long int val) {
-    const char *fmt = "%lld";
-    char buf[kNumSize];
-    int size = snprintf(buf, kNumSize, fmt, val);
-    return write(buf, size);
+    return writeSigned<long long int, unsigned long long int>(*this, val);
 }
 
 ostream& ostream::operator<<(unsigned long long int val) {
-    const char *fmt = "%llu";
-    char buf[kNumSize];
-    int size = snprintf(buf, kNumSize, fmt, val);
-    return write(buf, size);
+    return writeInteger(*this, val, false, false);
 }
 
-// Double max 1.7976931348623157E+308 = 23 < kNumSize so we reuse it.
 ostream& ostream::operator<<(double val) {
-    const char *fmt = "%.*e";
-    char buf[kNumSize];
-    int size = snprintf(buf, kNumSize, fmt, precision(), val);
-    return write(buf, size);
+    return writeFloat(*this, val);
 }
 
 ostream& ostream::operator<<(float val) {
-    const char *fmt = "%.*e";
-    char buf[kNumSize];
-    int size = snprintf(buf, kNumSize, fmt, precision(), val);
-    return write(buf, size);
+    return writeFloat(*this, val);
 }
 
 ostream& ostream::operator<<(const void *p) {
@@ -128,13 +616,6 @@ ostream& ostream::write_formatted(const char_type *str, streamsize num) {
     return write(str, num);
 }
 
-ostream& ostream::put(char_type c) {
-    if (this->rdbuf()) {
-        this->rdbuf()->sputn(&c, 1);
-    }
-    return *this;
-}
-
 ostream& ostream::write(const char_type *str, streamsize num) {
     if (this->rdbuf()) {
         this->rdbuf()->sputn(str, num);
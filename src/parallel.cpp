@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <parallel.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Thread pool shared by the android::par algorithms. The workers are
+// started on the first parallel run and wait on gWork for a new job
+// (gGeneration changes). The chunks are handed out with an atomic
+// counter; the calling thread processes chunks too then waits on
+// gDone for the workers still busy with the job.
+
+namespace {
+using android::par::Job;
+
+const size_t kMaxThreads = 64;
+
+// Held by the call running a job, at most one at a time.
+pthread_mutex_t gRunLock = PTHREAD_MUTEX_INITIALIZER;
+
+// Protect the fields below but gNext.
+pthread_mutex_t gLock = PTHREAD_MUTEX_INITIALIZER;
+pthread_cond_t gWork = PTHREAD_COND_INITIALIZER;
+pthread_cond_t gDone = PTHREAD_COND_INITIALIZER;
+
+size_t gThreadCount = 0;  // 0: one per CPU.
+size_t gGrainSize = android::par::kDefaultGrainSize;
+size_t gCpuCount = 0;
+
+pthread_t gWorkers[kMaxThreads];
+size_t gWorkerCount = 0;
+bool gExit = false;
+unsigned gGeneration = 0;
+Job *gJob = NULL;
+size_t gChunks = 0;
+size_t gActive = 0;  // Workers running the job.
+volatile size_t gNext = 0;  // Next chunk to run.
+
+void runChunks(Job *job, size_t chunks) {
+    for (;;) {
+        const size_t chunk = __sync_fetch_and_add(&gNext, 1);
+        if (chunk >= chunks) {
+            break;
+        }
+        job->run(chunk);
+    }
+}
+
+void *workerMain(void *) {
+    unsigned generation = 0;
+    pthread_mutex_lock(&gLock);
+    for (;;) {
+        while (!gExit && gGeneration == generation) {
+            pthread_cond_wait(&gWork, &gLock);
+        }
+        if (gExit) {
+            break;
+        }
+        generation = gGeneration;
+        if (gJob == NULL) {
+            continue;  // Woke up after the job was done.
+        }
+        Job *const job = gJob;
+        const size_t chunks = gChunks;
+        ++gActive;
+        pthread_mutex_unlock(&gLock);
+
+        runChunks(job, chunks);
+
+        pthread_mutex_lock(&gLock);
+        if (--gActive == 0) {
+            pthread_cond_signal(&gDone);
+        }
+    }
+    pthread_mutex_unlock(&gLock);
+    return NULL;
+}
+
+// Called with gLock held.
+void startWorkers(size_t count) {
+    while (gWorkerCount < count) {
+        if (pthread_create(&gWorkers[gWorkerCount], NULL, workerMain,
+                           NULL) != 0) {
+            break;  // Run with the workers we have.
+        }
+        ++gWorkerCount;
+    }
+}
+
+// Called with gRunLock held.
+void stopWorkers() {
+    pthread_mutex_lock(&gLock);
+    gExit = true;
+    pthread_cond_broadcast(&gWork);
+    pthread_mutex_unlock(&gLock);
+    for (size_t i = 0; i < gWorkerCount; ++i) {
+        pthread_join(gWorkers[i], NULL);
+    }
+    gWorkerCount = 0;
+    gExit = false;
+}
+}  // anonymous namespace
+
+namespace android {
+namespace par {
+
+void set_thread_count(size_t count) {
+    pthread_mutex_lock(&gRunLock);
+    stopWorkers();
+    gThreadCount = count < kMaxThreads ? count : kMaxThreads;
+    pthread_mutex_unlock(&gRunLock);
+}
+
+size_t thread_count() {
+    if (gThreadCount != 0) {
+        return gThreadCount;
+    }
+    if (gCpuCount == 0) {
+        const long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        gCpuCount = cpus < 1 ? 1 : (static_cast<size_t>(cpus) < kMaxThreads ?
+                                    static_cast<size_t>(cpus) : kMaxThreads);
+    }
+    return gCpuCount;
+}
+
+void set_grain_size(size_t grain) {
+    gGrainSize = grain == 0 ? kDefaultGrainSize : grain;
+}
+
+size_t grain_size() {
+    return gGrainSize;
+}
+
+void run(Job& job, size_t chunks) {
+    if (chunks <= 1 || thread_count() == 1 ||
+        pthread_mutex_trylock(&gRunLock) != 0) {
+        // Nothing to split or the pool is busy: run on this thread.
+        for (size_t i = 0; i < chunks; ++i) {
+            job.run(i);
+        }
+        return;
+    }
+    pthread_mutex_lock(&gLock);
+    startWorkers(thread_count() - 1);
+    gJob = &job;
+    gChunks = chunks;
+    gNext = 0;
+    ++gGeneration;
+    pthread_cond_broadcast(&gWork);
+    pthread_mutex_unlock(&gLock);
+
+    runChunks(&job, chunks);
+
+    pthread_mutex_lock(&gLock);
+    while (gActive != 0) {
+        pthread_cond_wait(&gDone, &gLock);
+    }
+    gJob = NULL;
+    pthread_mutex_unlock(&gLock);
+    pthread_mutex_unlock(&gRunLock);
+}
+
+}  // namespace par
+}  // namespace android
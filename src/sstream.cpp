@@ -35,34 +35,74 @@ namespace std {
 // basic_stringbuf
 
 basic_stringbuf::basic_stringbuf(ios_base::openmode mode) :
-    mMode(mode) { }
+    mMode(mode) {
+    setp(mBuffer, mBuffer + kBufferSize);
+}
 
 basic_stringbuf::basic_stringbuf(const string& str, ios_base::openmode mode) :
-    mMode(mode), mString(str) { }
+    mMode(mode), mString(str) {
+    setp(mBuffer, mBuffer + kBufferSize);
+}
 
 basic_stringbuf::~basic_stringbuf() { }
 
 const string& basic_stringbuf::str() const {
+    // The put area is not part of the observable state, flushing it
+    // leaves the content unchanged.
+    const_cast<basic_stringbuf*>(this)->FlushBuffer();
     return mString;
 }
 
 void basic_stringbuf::str(const string& str) {
+    setp(mBuffer, mBuffer + kBufferSize);
     mString = str;
 }
 
 streamsize basic_stringbuf::in_avail() {
     if (mMode & std::ios_base::in) {
+        FlushBuffer();
         return mString.size();
     } else {
         return -1;
     }
 }
 
+void basic_stringbuf::FlushBuffer() {
+    if (pptr() != pbase()) {
+        mString.append(pbase(), pptr() - pbase());
+        setp(mBuffer, mBuffer + kBufferSize);
+    }
+}
+
 streamsize basic_stringbuf::xsputn(const char_type* str, streamsize num) {
+    if (num <= 0) {
+        return 0;
+    }
+    if (num <= epptr() - pptr()) {
+        traits_type::copy(pptr(), str, num);
+        pbump(num);
+        return num;
+    }
+    FlushBuffer();
     mString.append(str, num);
     return num;
 }
 
+basic_stringbuf::int_type basic_stringbuf::overflow(int_type c) {
+    FlushBuffer();
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+        return traits_type::not_eof(c);
+    }
+    *pptr() = traits_type::to_char(c);
+    pbump(1);
+    return c;
+}
+
+int basic_stringbuf::sync() {
+    FlushBuffer();
+    return 0;
+}
+
 
 // stringstream
 
@@ -79,9 +119,4 @@ stringstream::stringstream(const string& str,
 
 stringstream::~stringstream() {}
 
-ostream& stringstream::put(char c) {
-    mStringBuf.sputc(c);
-    return *this;
-}
-
 }  // namespace std
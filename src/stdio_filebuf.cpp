@@ -32,20 +32,72 @@
 #include <streambuf>
 
 namespace android {
-stdio_filebuf::stdio_filebuf(std::FILE* stream)
+
+stdio_filebuf::stdio_filebuf(std::FILE* stream, bool buffered)
     : mStream(stream) {
+    if (buffered) {
+        setp(mBuffer, mBuffer + kBufferSize);
+    }
 }
 
 stdio_filebuf::~stdio_filebuf() {
+    FlushBuffer();
+}
+
+bool stdio_filebuf::FlushBuffer() {
+    const size_t len = pptr() - pbase();
+    if (len == 0) {
+        return true;
+    }
+    const size_t written = fwrite(pbase(), 1, len, mStream);
+    // On error, drop the part written and keep the rest.
+    traits_type::move(pbase(), pbase() + written, len - written);
+    setp(pbase(), epptr());
+    pbump(len - written);
+    return written == len;
 }
 
 std::streamsize
 stdio_filebuf::xsputn(const std::streambuf::char_type* str, std::streamsize num) {
-    return fprintf(mStream, "%.*s", num, str);
+    if (num <= 0) {
+        return 0;
+    }
+    if (num <= epptr() - pptr()) {
+        traits_type::copy(pptr(), str, num);
+        pbump(num);
+        return num;
+    }
+    if (!FlushBuffer()) {
+        return 0;
+    }
+    if (num < epptr() - pbase()) {
+        traits_type::copy(pptr(), str, num);
+        pbump(num);
+        return num;
+    }
+    // Larger than the buffer (or unbuffered): write it directly.
+    return fwrite(str, 1, num, mStream);
+}
+
+stdio_filebuf::int_type stdio_filebuf::overflow(int_type c) {
+    if (!FlushBuffer()) {
+        return traits_type::eof();
+    }
+    if (traits_type::eq_int_type(c, traits_type::eof())) {
+        return traits_type::not_eof(c);
+    }
+    const char_type ch = traits_type::to_char(c);
+    if (pptr() < epptr()) {
+        *pptr() = ch;
+        pbump(1);
+        return c;
+    }
+    return fwrite(&ch, 1, 1, mStream) == 1 ? c : traits_type::eof();
 }
 
 int stdio_filebuf::sync() {
-    return fflush(mStream);
+    const bool flushed = FlushBuffer();
+    return fflush(mStream) == 0 && flushed ? 0 : -1;
 }
 
 }  // namespace android
@@ -48,75 +48,109 @@ char sDummy;
 namespace std {
 // Implementation of the std::string class.
 //
-// mData points either to a heap allocated array of bytes or the constant
-// kEmptyString when empty and reserve has not been called.
+// The characters are stored in mInline when the capacity is at most
+// kInlineCapacity. Otherwise mLong.mData points either to a heap
+// allocated array of bytes or to the constant kEmptyString when empty
+// and reserve has not been called. Use Buffer(), Length() and
+// capacity() to access the representation.
 //
-// The size of the buffer pointed by mData is mCapacity + 1.
+// The size of the buffer is capacity() + 1.
 // The extra byte is need to store the '\0'.
 //
-// mCapacity is either mLength or the number of bytes reserved using
-// reserve(int)).
+// The capacity is either the length, the number of bytes reserved
+// using reserve(int)) or the geometrically grown capacity (see Grow)
+// when characters are appended.
 //
-// mLength is the number of char in the string, excluding the terminating '\0'.
+// The length is the number of char in the string, excluding the
+// terminating '\0'.
 //
 // TODO: replace the overflow checks with some better named macros.
 //
-// Allocate n + 1 number of bytes for the string. Update mCapacity.
-// Ensure that mCapacity + 1 and mLength + 1 is accessible.
-// In case of error the original state of the string is restored.
+// Allocate n + 1 number of bytes for an uninitialized string. The
+// length is 0 and the terminator is not written.
 // @param n Number of bytes requested. String allocate n + 1 to hold
-//            the terminating '\0'.
+//            the terminating '\0'. The inline buffer is used if n is
+//            small enough.
 // @return true if the buffer could be allocated, false otherwise.
 bool string::SafeMalloc(size_type n)
 {
     // Not empty and no overflow
-    if (n > 0 && n + 1 > n)
+    if (n > 0 && n <= kMaxCapacity)
     {
-        value_type *oldData = mData;
-
-        mData = static_cast<value_type *>(::malloc(n + 1));
-        if (NULL != mData)
+        if (n <= kInlineCapacity)
+        {
+            SetInline(n, 0);
+            return true;
+        }
+        value_type *const data = static_cast<value_type *>(::malloc(n + 1));
+        if (NULL != data)
         {
-            mCapacity = n;
+            SetLong(data, n, 0);
             return true;
         }
-        mData = oldData;  // roll back
     }
     return false;
 }
 
-// Resize the buffer pointed by mData if n >= mLength.
-// mData points to an allocated buffer or the empty string.
+// Resize the buffer if n >= length. The characters are moved between
+// the inline buffer and the heap as needed.
+// In case of error the original state of the string is restored.
 // @param n The number of bytes for the internal buffer.
-//            Must be > mLength and > 0.
+//            Must be > length and > 0.
 void string::SafeRealloc(size_type n)
 {
+    const size_type len = Length();
     // truncation or nothing to do or n too big (overflow)
-    if (n < mLength || n == mCapacity || n + 1 < n) {
+    if (n < len || n == capacity() || n > kMaxCapacity) {
         return;
     }
 
-    if (kEmptyString == mData)
+    if (IsInline())
     {
-        if (SafeMalloc(n)) {
-            *mData = '\0';
+        if (n <= kInlineCapacity)
+        {
+            SetInline(n, len);
+            return;
+        }
+        // Move from the inline buffer to the heap.
+        value_type *newData = static_cast<value_type *>(::malloc(n + 1));
+        if (NULL != newData)
+        {
+            memcpy(newData, mInline, len + 1);
+            SetLong(newData, n, len);
         }
         return;
     }
 
-    value_type *oldData = mData;
+    value_type *const oldData = mLong.mData;
 
-    mData = static_cast<char*>(::realloc(mData, n + 1));
-    if (NULL == mData) // reallocate failed.
+    if (n <= kInlineCapacity)
+    {  // Move from the heap to the inline buffer, this overwrites mLong.
+        memcpy(mInline, oldData, len + 1);
+        SetInline(n, len);
+        SafeFree(oldData);
+        return;
+    }
+
+    if (kEmptyString == oldData)
     {
-        mData = oldData;
+        value_type *newData = static_cast<value_type *>(::malloc(n + 1));
+        if (NULL != newData)
+        {
+            *newData = '\0';
+            SetLong(newData, n, 0);
+        }
+        return;
     }
-    else
+
+    value_type *newData = static_cast<char*>(::realloc(oldData, n + 1));
+    if (NULL != newData) // reallocate succeeded.
     {
-        mCapacity = n;
+        SetLong(newData, n, len);
     }
 }
 
+// Do nothing if we point at the empty string.
 void string::SafeFree(value_type *buffer)
 {
     if (buffer != kEmptyString)
@@ -125,19 +159,19 @@ void string::SafeFree(value_type *buffer)
     }
 }
 
-// If the memory is on the heap, release it. Do nothing we we point at the empty
-// string. On return mData points to str.
-void string::ResetTo(value_type *str)
+// If the memory is on the heap, release it. The representation is
+// left as is.
+void string::Release()
 {
-    SafeFree(mData);
-    mData = str;
+    if (!IsInline())
+    {
+        SafeFree(mLong.mData);
+    }
 }
 
 void string::ConstructEmptyString()
 {
-    mData = kEmptyString;
-    mLength = 0;
-    mCapacity = 0;
+    SetLong(kEmptyString, 0, 0);
 }
 
 void string::Constructor(const value_type *str, size_type n)
@@ -151,9 +185,10 @@ void string::Constructor(const value_type *str, size_type pos, size_type n)
     // Enough data and no overflow
     if (SafeMalloc(n))
     {
-        memcpy(mData, str + pos, n);
-        mLength = n;
-        mData[mLength] = '\0';
+        value_type *const data = Buffer();
+        memcpy(data, str + pos, n);
+        SetLength(n);
+        data[n] = '\0';
         return;  // Success
     }
     ConstructEmptyString();
@@ -165,9 +200,10 @@ void string::Constructor(size_type n, char c)
 
     if (SafeMalloc(n))
     {
-        memset(mData, c, n);
-        mLength = n;
-        mData[mLength] = '\0';
+        value_type *const data = Buffer();
+        memset(data, c, n);
+        SetLength(n);
+        data[n] = '\0';
         return;  // Success
     }
     ConstructEmptyString();
@@ -180,17 +216,17 @@ string::string()
 
 string::string(const string& str)
 {
-    Constructor(str.mData, str.mLength);
+    Constructor(str.Buffer(), str.Length());
 }
 
 string::string(const string& str, size_type pos, size_type n)
 {
-    if (pos < str.mLength)
+    if (pos < str.Length())
     {
-        if (n > (str.mLength - pos)) {
-            n = str.mLength - pos;
+        if (n > (str.Length() - pos)) {
+            n = str.Length() - pos;
         }
-        Constructor(str.mData + pos , n);
+        Constructor(str.Buffer() + pos , n);
     }
     else
     {
@@ -200,9 +236,9 @@ string::string(const string& str, size_type pos, size_type n)
 
 string::string(const string& str, size_type pos)
 {
-    if (pos < str.mLength)
+    if (pos < str.Length())
     {
-        Constructor(str.mData, pos, str.mLength - pos);
+        Constructor(str.Buffer(), pos, str.Length() - pos);
     }
     else
     {
@@ -252,56 +288,85 @@ string::~string()
 
 void string::clear()
 {
-    mCapacity = 0;
-    mLength = 0;
-    ResetTo(kEmptyString);
+    Release();
+    ConstructEmptyString();
 }
 
 string& string::erase(size_type pos, size_type n)
 {
-    if (pos >= mLength || 0 == n)
+    const size_type len = Length();
+    if (pos >= len || 0 == n)
     {
         return *this;
     }
     // start of the characters left which need to be moved down.
     const size_t remainder = pos + n;
 
+    value_type *const data = Buffer();
+
     // Truncate, even if there is an overflow.
-    if (remainder >= mLength || remainder < pos)
+    if (remainder >= len || remainder < pos)
     {
-        *(mData + pos) = '\0';
-        mLength = pos;
+        *(data + pos) = '\0';
+        SetLength(pos);
         return *this;
     }
-    // remainder < mLength and allocation guarantees to be at least
-    // mLength + 1
-    size_t left = mLength - remainder + 1;
-    value_type *d = mData + pos;
-    value_type *s = mData + remainder;
+    // remainder < len and allocation guarantees to be at least
+    // len + 1
+    size_t left = len - remainder + 1;
+    value_type *d = data + pos;
+    value_type *s = data + remainder;
     memmove(d, s, left);
-    mLength -= n;
+    SetLength(len - n);
     return *this;
 }
 
 void string::Append(const value_type *str, size_type n)
 {
-    const size_type total_len = mLength + n;
+    const size_type len = Length();
+    const size_type total_len = len + n;
 
     // n > 0 and no overflow for the string length + terminating null.
-    if (n > 0 && (total_len + 1) > mLength)
+    if (n > 0 && (total_len + 1) > len)
     {
-        if (total_len > mCapacity)
-        {
-            reserve(total_len);
-            if (total_len > mCapacity)
-            {  // something went wrong in the reserve call.
-                return;
-            }
+        if (!Grow(total_len))
+        {  // something went wrong in the reserve call.
+            return;
         }
-        memcpy(mData + mLength, str, n);
-        mLength = total_len;
-        mData[mLength] = '\0';
+        value_type *const data = Buffer();
+        memcpy(data + len, str, n);
+        SetLength(total_len);
+        data[total_len] = '\0';
+    }
+}
+
+// Make sure the capacity is at least n. The capacity grows
+// geometrically so repeated appends don't realloc every time. If the
+// geometric capacity cannot be allocated, falls back to n.
+// @param n The minimum capacity needed.
+// @return true if the capacity is at least n on return.
+bool string::Grow(size_type n)
+{
+    const size_type old_capacity = capacity();
+    if (n <= old_capacity)
+    {
+        return true;
+    }
+    const size_type increment = old_capacity / kGrowthDenominator *
+            (kGrowthNumerator - kGrowthDenominator);
+    size_type new_capacity = old_capacity + increment;
+
+    // Not enough or overflow (no room for the terminating '\0').
+    if (new_capacity < n || new_capacity + 1 < new_capacity)
+    {
+        new_capacity = n;
+    }
+    reserve(new_capacity);
+    if (n > capacity() && new_capacity != n)
+    {
+        reserve(n);
     }
+    return n <= capacity();
 }
 
 string& string::append(const value_type *str)
@@ -333,7 +398,7 @@ string& string::append(const value_type *str, size_type pos, size_type n)
 
 string& string::append(const string& str)
 {
-    Append(str.mData, str.mLength);
+    Append(str.Buffer(), str.Length());
     return *this;
 }
 
@@ -355,22 +420,33 @@ string& string::append<__wrapper_iterator<char *,string> >(
 
 void string::push_back(const char c)
 {
+    // Fast path for the long strings that have room left.
+    if (!IsInline())
+    {
+        const size_type len = mLong.mLength;
+        if (len < capacity())
+        {
+            value_type *const data = mLong.mData;
+            data[len] = c;
+            data[len + 1] = '\0';
+            mLong.mLength = len + 1;
+            return;
+        }
+    }
     // Check we don't overflow.
-    if (mLength + 2 > mLength)
+    const size_type len = Length();
+    if (len + 2 > len)
     {
-        const size_type total_len = mLength + 1;
+        const size_type total_len = len + 1;
 
-        if (total_len > mCapacity)
-        {
-            reserve(total_len);
-            if (total_len > mCapacity)
-            {  // something went wrong in the reserve call.
-                return;
-            }
+        if (!Grow(total_len))
+        {  // something went wrong in the reserve call.
+            return;
         }
-        *(mData + mLength) = c;
-        ++mLength;
-        mData[mLength] = '\0';
+        value_type *const data = Buffer();
+        *(data + len) = c;
+        SetLength(total_len);
+        data[total_len] = '\0';
     }
 }
 
@@ -381,13 +457,15 @@ int string::compare(const string& other) const
     {
         return 0;
     }
-    else if (mLength == other.mLength)
+    const size_type len = Length();
+    const size_type other_len = other.Length();
+    if (len == other_len)
     {
-        return memcmp(mData, other.mData, mLength);
+        return memcmp(Buffer(), other.Buffer(), len);
     }
     else
     {
-        return mLength < other.mLength ? -1 : 1;
+        return len < other_len ? -1 : 1;
     }
 }
 
@@ -397,7 +475,7 @@ int string::compare(const value_type *other) const
     {
         return 1;
     }
-    return strcmp(mData, other);
+    return strcmp(Buffer(), other);
 }
 
 bool operator==(const string& left, const string& right)
@@ -406,7 +484,7 @@ bool operator==(const string& left, const string& right)
         return true;
     }
     return (left.size() == right.size() &&
-            !char_traits<char>::compare(left.mData, right.mData, left.size()));
+            !char_traits<char>::compare(left.c_str(), right.c_str(), left.size()));
 }
 
 bool operator==(const string& left, const string::value_type *right)
@@ -416,28 +494,29 @@ bool operator==(const string& left, const string::value_type *right)
     }
     // We can use strcmp here because even when the string is build from an
     // array of char we insert the terminating '\0'.
-    return std::strcmp(left.mData, right) == 0;
+    return std::strcmp(left.c_str(), right) == 0;
 }
 
 void string::reserve(size_type size)
 {
+    const size_type len = Length();
     if (0 == size)
     {
-        if (0 == mCapacity)
+        if (0 == capacity())
         {
             return;
         }
-        else if (0 == mLength)
+        else if (0 == len)
         {  // Shrink to fit an empty string.
-            mCapacity = 0;
-            ResetTo(kEmptyString);
+            Release();
+            ConstructEmptyString();
         }
         else
         {  // Shrink to fit a non empty string
-            SafeRealloc(mLength);
+            SafeRealloc(len);
         }
     }
-    else if (size > mLength)
+    else if (size > len)
     {
         SafeRealloc(size);
     }
@@ -446,33 +525,28 @@ void string::reserve(size_type size)
 void string::swap(string& other)
 {
     if (this == &other) return;
-    value_type *const tmp_mData = mData;
-    const size_type tmp_mCapacity = mCapacity;
-    const size_type tmp_mLength = mLength;
-
-    mData = other.mData;
-    mCapacity = other.mCapacity;
-    mLength = other.mLength;
+    // Both representations are bitwise movable.
+    value_type tmp_mInline[kInlineSize];
 
-    other.mData = tmp_mData;
-    other.mCapacity = tmp_mCapacity;
-    other.mLength = tmp_mLength;
+    memcpy(tmp_mInline, mInline, sizeof(mInline));
+    memcpy(mInline, other.mInline, sizeof(mInline));
+    memcpy(other.mInline, tmp_mInline, sizeof(mInline));
 }
 
 const char& string::operator[](const size_type pos) const
 {
-    return mData[pos];
+    return Buffer()[pos];
 }
 
 char& string::operator[](const size_type pos)
 {
-    return mData[pos];
+    return Buffer()[pos];
 }
 
 const char& string::at(const size_type pos) const
 {
-    if (pos < mLength) {
-        return mData[pos];
+    if (pos < Length()) {
+        return Buffer()[pos];
     } else {
         sDummy = 'X';
         return sDummy;
@@ -481,8 +555,8 @@ const char& string::at(const size_type pos) const
 
 char& string::at(const size_type pos)
 {
-    if (pos < mLength) {
-        return mData[pos];
+    if (pos < Length()) {
+        return Buffer()[pos];
     } else {
         sDummy = 'X';
         return sDummy;
@@ -492,20 +566,20 @@ char& string::at(const size_type pos)
 string& string::assign(const string& str)
 {
     clear();
-    Constructor(str.mData, str.mLength);
+    Constructor(str.Buffer(), str.Length());
     return *this;
 }
 
 string& string::assign(const string& str, size_type pos, size_type n)
 {
-    if (pos >= str.mLength)
+    if (pos >= str.Length())
     {  // pos is out of bound
         return *this;
     }
-    if (n <= str.mLength - pos)
+    if (n <= str.Length() - pos)
     {
         clear();
-        Constructor(str.mData, pos, n);
+        Constructor(str.Buffer(), pos, n);
     }
     return *this;
 }
@@ -533,27 +607,28 @@ string& string::assign(const value_type *array, size_type n)
 }
 
 string::iterator string::insert(iterator iter, char c) {
-    const size_type new_len = mLength + 1;
+    const size_type len = Length();
+    const size_type new_len = len + 1;
     char *base = iter.base();
 
-    if (base < mData || base > mData + mLength || new_len < mLength) {
+    value_type *data = Buffer();
+
+    if (base < data || base > data + len || new_len < len) {
         return iterator(&sDummy);  // out of bound || overflow
     }
 
-    const size_type pos = base - mData;
-    if (new_len > mCapacity) {
-        reserve(new_len);
-        if (new_len > mCapacity) {
-            return iterator(&sDummy);  // not enough memory?
-        }
+    const size_type pos = base - data;
+    if (!Grow(new_len)) {
+        return iterator(&sDummy);  // not enough memory?
     }
-    // At this point 'iter' and 'base' are not valid anymore since
-    // realloc could have taken place.
-    base = mData + pos;
-    std::memmove(base + 1, base, mLength - pos);
+    // At this point 'iter', 'base' and 'data' are not valid anymore
+    // since realloc could have taken place.
+    data = Buffer();
+    base = data + pos;
+    std::memmove(base + 1, base, len - pos);
     *base = c;
-    mLength = new_len;
-    mData[mLength] = 0;
+    SetLength(new_len);
+    data[new_len] = 0;
     return iterator(base);
 }
 
@@ -574,25 +649,27 @@ string::size_type string::find(const value_type *str, size_type pos) const
 
     // Empty string is found everywhere except beyond the end. It is
     // possible to find the empty string right after the last char,
-    // hence we used mLength and not mLength - 1 in the comparison.
+    // hence we used the length and not the length - 1 in the comparison.
+    const size_type len = Length();
     if (*str == '\0')
     {
-        return pos > mLength ? string::npos : pos;
+        return pos > len ? string::npos : pos;
     }
 
-    if (mLength == 0 || pos > mLength - 1)
+    if (len == 0 || pos > len - 1)
     {
         return string::npos;
     }
 
-    value_type *idx = std::strstr(mData + pos, str);
+    const value_type *const data = Buffer();
+    const value_type *idx = std::strstr(data + pos, str);
 
     if (NULL == idx)
     {
         return string::npos;
     }
 
-    const std::ptrdiff_t delta = idx - mData;
+    const std::ptrdiff_t delta = idx - data;
 
     return static_cast<size_type>(delta);
 }
@@ -602,32 +679,37 @@ string string::substr(size_type pos, size_type n) const {
 }
 
 string::size_type string::find_first_of(value_type c, size_type pos) const {
-    if (pos >= mLength) {
+    const size_type len = Length();
+    if (pos >= len) {
         return npos;
     }
+    const char *const data = Buffer();
     const char *res;
     // The last parameter represents a number of chars, not a index.
-    res = static_cast<const char *>(std::memchr(mData + pos, c, mLength - pos));
-    return res != NULL ? res - mData : npos;
+    res = static_cast<const char *>(std::memchr(data + pos, c, len - pos));
+    return res != NULL ? res - data : npos;
 }
 
 string::size_type string::find_last_of(value_type c, size_type pos) const {
-    if (mLength == 0) {
+    const size_type len = Length();
+    if (len == 0) {
         return npos;
-    } else if (pos >= mLength) {
-        pos = mLength - 1;  // >= 0
+    } else if (pos >= len) {
+        pos = len - 1;  // >= 0
     }
 
+    const char *const data = Buffer();
     const char *res;
     // Note:memrchr is not in the std namepace.
     // The last parameter represents a number of chars, not a index.
-    res = static_cast<const char *>(memrchr(mData, c, pos + 1));
-    return res != NULL ? res - mData : npos;
+    res = static_cast<const char *>(memrchr(data, c, pos + 1));
+    return res != NULL ? res - data : npos;
 }
 
 string::size_type string::find_first_not_of(value_type c, size_type pos) const {
-    char *curr = mData + pos;
-    for (size_type i = pos; i < mLength; ++i, ++curr) {
+    const size_type len = Length();
+    char *curr = Buffer() + pos;
+    for (size_type i = pos; i < len; ++i, ++curr) {
         if (c != *curr) {
             return i;
         }
@@ -636,13 +718,14 @@ string::size_type string::find_first_not_of(value_type c, size_type pos) const {
 }
 
 string::size_type string::find_last_not_of(value_type c, size_type pos) const {
-    if (mLength == 0) {
+    const size_type len = Length();
+    if (len == 0) {
         return npos;
-    } else if (pos >= mLength) {
-        pos = mLength - 1;  // >= 0
+    } else if (pos >= len) {
+        pos = len - 1;  // >= 0
     }
 
-    char *curr = mData + pos;
+    char *curr = Buffer() + pos;
     size_type i = pos;
 
     for (;; --i, --curr) {
@@ -0,0 +1,355 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include <tree.h>
+#include <algorithm>
+
+namespace {
+using android::TreeNodeBase;
+
+// Rotate the subtree rooted at node to the left: node's right child
+// takes its place.
+void rotateLeft(TreeNodeBase *node, TreeNodeBase *&root) {
+    TreeNodeBase *const right = node->mRight;
+
+    node->mRight = right->mLeft;
+    if (right->mLeft != NULL) {
+        right->mLeft->mParent = node;
+    }
+    right->mParent = node->mParent;
+
+    if (node == root) {
+        root = right;
+    } else if (node == node->mParent->mLeft) {
+        node->mParent->mLeft = right;
+    } else {
+        node->mParent->mRight = right;
+    }
+    right->mLeft = node;
+    node->mParent = right;
+}
+
+// Mirror of rotateLeft.
+void rotateRight(TreeNodeBase *node, TreeNodeBase *&root) {
+    TreeNodeBase *const left = node->mLeft;
+
+    node->mLeft = left->mRight;
+    if (left->mRight != NULL) {
+        left->mRight->mParent = node;
+    }
+    left->mParent = node->mParent;
+
+    if (node == root) {
+        root = left;
+    } else if (node == node->mParent->mRight) {
+        node->mParent->mRight = left;
+    } else {
+        node->mParent->mLeft = left;
+    }
+    left->mRight = node;
+    node->mParent = left;
+}
+
+bool isBlack(const TreeNodeBase *node) {
+    return node == NULL || node->mColor == TreeNodeBase::kBlack;
+}
+}  // anonymous namespace
+
+namespace android {
+
+void TreeNodeBase::init() {
+    mColor = kRed;
+    mParent = NULL;
+    mLeft = this;
+    mRight = this;
+}
+
+TreeNodeBase *TreeNodeBase::minimum(TreeNodeBase *node) {
+    while (node->mLeft != NULL) {
+        node = node->mLeft;
+    }
+    return node;
+}
+
+TreeNodeBase *TreeNodeBase::maximum(TreeNodeBase *node) {
+    while (node->mRight != NULL) {
+        node = node->mRight;
+    }
+    return node;
+}
+
+TreeNodeBase *TreeNodeBase::next(TreeNodeBase *node) {
+    if (node->mRight != NULL) {
+        return minimum(node->mRight);
+    }
+    TreeNodeBase *parent = node->mParent;
+    while (node == parent->mRight) {
+        node = parent;
+        parent = parent->mParent;
+    }
+    // When node is the root with no right child, we went up to the
+    // header (parent is the root): the header is the next node.
+    return node->mRight != parent ? parent : node;
+}
+
+TreeNodeBase *TreeNodeBase::prev(TreeNodeBase *node) {
+    if (node->mColor == kRed && node->mParent->mParent == node) {
+        // node is the header (the root's parent is the header and
+        // the root is black): previous is the rightmost node.
+        return node->mRight;
+    }
+    if (node->mLeft != NULL) {
+        return maximum(node->mLeft);
+    }
+    TreeNodeBase *parent = node->mParent;
+    while (node == parent->mLeft) {
+        node = parent;
+        parent = parent->mParent;
+    }
+    return parent;
+}
+
+void TreeNodeBase::insertAndRebalance(bool insert_left, TreeNodeBase *node,
+                                      TreeNodeBase *parent,
+                                      TreeNodeBase& header) {
+    TreeNodeBase *&root = header.mParent;
+
+    node->mParent = parent;
+    node->mLeft = NULL;
+    node->mRight = NULL;
+    node->mColor = kRed;
+
+    if (insert_left) {
+        parent->mLeft = node;  // leftmost = node when parent is the header.
+        if (parent == &header) {
+            root = node;
+            header.mRight = node;
+        } else if (parent == header.mLeft) {
+            header.mLeft = node;
+        }
+    } else {
+        parent->mRight = node;
+        if (parent == header.mRight) {
+            header.mRight = node;
+        }
+    }
+
+    // Restore the red-black properties: a red node has no red child.
+    while (node != root && node->mParent->mColor == kRed) {
+        TreeNodeBase *const grandparent = node->mParent->mParent;
+
+        if (node->mParent == grandparent->mLeft) {
+            TreeNodeBase *const uncle = grandparent->mRight;
+            if (!isBlack(uncle)) {
+                node->mParent->mColor = kBlack;
+                uncle->mColor = kBlack;
+                grandparent->mColor = kRed;
+                node = grandparent;
+            } else {
+                if (node == node->mParent->mRight) {
+                    node = node->mParent;
+                    rotateLeft(node, root);
+                }
+                node->mParent->mColor = kBlack;
+                grandparent->mColor = kRed;
+                rotateRight(grandparent, root);
+            }
+        } else {
+            TreeNodeBase *const uncle = grandparent->mLeft;
+            if (!isBlack(uncle)) {
+                node->mParent->mColor = kBlack;
+                uncle->mColor = kBlack;
+                grandparent->mColor = kRed;
+                node = grandparent;
+            } else {
+                if (node == node->mParent->mLeft) {
+                    node = node->mParent;
+                    rotateRight(node, root);
+                }
+                node->mParent->mColor = kBlack;
+                grandparent->mColor = kRed;
+                rotateLeft(grandparent, root);
+            }
+        }
+    }
+    root->mColor = kBlack;
+}
+
+void TreeNodeBase::eraseAndRebalance(TreeNodeBase *node, TreeNodeBase& header) {
+    TreeNodeBase *&root = header.mParent;
+    TreeNodeBase *&leftmost = header.mLeft;
+    TreeNodeBase *&rightmost = header.mRight;
+
+    // 'spliced' is the node actually unlinked from its position:
+    // either node if it has at most one child or its successor.
+    // 'child' replaces 'spliced' (may be NULL), child_parent is its
+    // new parent.
+    TreeNodeBase *spliced = node;
+    TreeNodeBase *child;
+    TreeNodeBase *child_parent;
+
+    if (node->mLeft == NULL) {
+        child = node->mRight;
+    } else if (node->mRight == NULL) {
+        child = node->mLeft;
+    } else {
+        spliced = minimum(node->mRight);
+        child = spliced->mRight;
+    }
+
+    if (spliced != node) {
+        // Relink the successor in place of node.
+        node->mLeft->mParent = spliced;
+        spliced->mLeft = node->mLeft;
+        if (spliced != node->mRight) {
+            child_parent = spliced->mParent;
+            if (child != NULL) {
+                child->mParent = spliced->mParent;
+            }
+            spliced->mParent->mLeft = child;
+            spliced->mRight = node->mRight;
+            node->mRight->mParent = spliced;
+        } else {
+            child_parent = spliced;
+        }
+        if (root == node) {
+            root = spliced;
+        } else if (node->mParent->mLeft == node) {
+            node->mParent->mLeft = spliced;
+        } else {
+            node->mParent->mRight = spliced;
+        }
+        spliced->mParent = node->mParent;
+        std::swap(spliced->mColor, node->mColor);
+        // node's color is now the color of the removed position.
+    } else {
+        child_parent = node->mParent;
+        if (child != NULL) {
+            child->mParent = node->mParent;
+        }
+        if (root == node) {
+            root = child;
+        } else if (node->mParent->mLeft == node) {
+            node->mParent->mLeft = child;
+        } else {
+            node->mParent->mRight = child;
+        }
+        if (leftmost == node) {
+            leftmost = node->mRight == NULL ? node->mParent : minimum(child);
+        }
+        if (rightmost == node) {
+            rightmost = node->mLeft == NULL ? node->mParent : maximum(child);
+        }
+    }
+
+    if (node->mColor == kRed) {
+        return;  // Removing a red node does not change the black height.
+    }
+
+    // child carries an extra black, move it up until it can be absorbed.
+    while (child != root && isBlack(child)) {
+        if (child == child_parent->mLeft) {
+            TreeNodeBase *sibling = child_parent->mRight;
+            if (sibling->mColor == kRed) {
+                sibling->mColor = kBlack;
+                child_parent->mColor = kRed;
+                rotateLeft(child_parent, root);
+                sibling = child_parent->mRight;
+            }
+            if (isBlack(sibling->mLeft) && isBlack(sibling->mRight)) {
+                sibling->mColor = kRed;
+                child = child_parent;
+                child_parent = child_parent->mParent;
+            } else {
+                if (isBlack(sibling->mRight)) {
+                    sibling->mLeft->mColor = kBlack;
+                    sibling->mColor = kRed;
+                    rotateRight(sibling, root);
+                    sibling = child_parent->mRight;
+                }
+                sibling->mColor = child_parent->mColor;
+                child_parent->mColor = kBlack;
+                if (sibling->mRight != NULL) {
+                    sibling->mRight->mColor = kBlack;
+                }
+                rotateLeft(child_parent, root);
+                break;
+            }
+        } else {
+            TreeNodeBase *sibling = child_parent->mLeft;
+            if (sibling->mColor == kRed) {
+                sibling->mColor = kBlack;
+                child_parent->mColor = kRed;
+                rotateRight(child_parent, root);
+                sibling = child_parent->mLeft;
+            }
+            if (isBlack(sibling->mRight) && isBlack(sibling->mLeft)) {
+                sibling->mColor = kRed;
+                child = child_parent;
+                child_parent = child_parent->mParent;
+            } else {
+                if (isBlack(sibling->mLeft)) {
+                    sibling->mRight->mColor = kBlack;
+                    sibling->mColor = kRed;
+                    rotateLeft(sibling, root);
+                    sibling = child_parent->mLeft;
+                }
+                sibling->mColor = child_parent->mColor;
+                child_parent->mColor = kBlack;
+                if (sibling->mLeft != NULL) {
+                    sibling->mLeft->mColor = kBlack;
+                }
+                rotateRight(child_parent, root);
+                break;
+            }
+        }
+    }
+    if (child != NULL) {
+        child->mColor = kBlack;
+    }
+}
+
+void TreeNodeBase::swap(TreeNodeBase& a, TreeNodeBase& b) {
+    std::swap(a.mParent, b.mParent);
+    std::swap(a.mLeft, b.mLeft);
+    std::swap(a.mRight, b.mRight);
+
+    // Fix the root's parent or reset the empty header.
+    if (a.mParent != NULL) {
+        a.mParent->mParent = &a;
+    } else {
+        a.mLeft = a.mRight = &a;
+    }
+    if (b.mParent != NULL) {
+        b.mParent->mParent = &b;
+    } else {
+        b.mLeft = b.mRight = &b;
+    }
+}
+
+}  // namespace android
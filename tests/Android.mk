@@ -44,6 +44,7 @@ $(foreach file,$(1), \
   $(eval LOCAL_CFLAGS += $(4)) \
   $(eval LOCAL_STATIC_LIBRARIES := $(libastl_test$(5)_static_lib)) \
   $(eval LOCAL_MODULE_TAGS := $(2) ) \
+  $(eval LOCAL_LDLIBS := $(if $(3),-lpthread)) \
   $(eval $(if $(3),,LOCAL_MODULE_PATH := $(TARGET_OUT_DATA_APPS))) \
   $(eval include $(BUILD_$(3)EXECUTABLE)) \
 )
@@ -63,6 +64,8 @@ endef
 sources := \
    test_algorithm.cpp \
    test_char_traits.cpp \
+   test_eytzinger.cpp \
+   test_fd_filebuf.cpp \
    test_functional.cpp \
    test_ios_base.cpp \
    test_iomanip.cpp \
@@ -71,13 +74,20 @@ sources := \
    test_iterator.cpp \
    test_limits.cpp \
    test_list.cpp \
+   test_map.cpp \
    test_memory.cpp \
+   test_parallel.cpp \
+   test_queue.cpp \
+   test_radix_sort.cpp \
    test_set.cpp \
    test_sstream.cpp \
+   test_stdio_filebuf.cpp \
    test_streambuf.cpp \
    test_string.cpp \
    test_type_traits.cpp \
    test_uninitialized.cpp \
+   test_unordered_map.cpp \
+   test_unordered_set.cpp \
    test_vector.cpp
 
 ifeq ($(HOST_OS),linux)
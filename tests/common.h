@@ -30,6 +30,20 @@
 #ifndef ANDROID_ASTL_TESTS_COMMON__
 #define ANDROID_ASTL_TESTS_COMMON__
 #include <cstdio>
+#include <malloc.h>
+
+// The sanitizers replace malloc: ask their allocator.
+#if defined(__SANITIZE_ADDRESS__)
+#define ASTL_TESTS_SANITIZER_HEAP 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define ASTL_TESTS_SANITIZER_HEAP 1
+#endif
+#endif
+#ifdef ASTL_TESTS_SANITIZER_HEAP
+// From sanitizer/allocator_interface.h, not always installed.
+extern "C" size_t __sanitizer_get_current_allocated_bytes();
+#endif
 
 // Classes and macros used in tests.
 namespace {
@@ -47,6 +61,19 @@ const int kFailed = 1;
 #define EXPECT_FALSE(expr) EXPECT_TRUE(!(expr))
 
 
+// @return The number of bytes allocated on the heap. Used to check
+// that some operations don't allocate any memory.
+inline size_t heapAllocatedBytes() {
+#if defined(ASTL_TESTS_SANITIZER_HEAP)
+    return __sanitizer_get_current_allocated_bytes();
+#elif defined(__GLIBC__) && \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    return mallinfo2().uordblks;  // mallinfo() is deprecated.
+#else
+    return mallinfo().uordblks;
+#endif
+}
+
 #ifndef ARRAYSIZE
 #define ARRAYSIZE(array) (sizeof(array)/sizeof(array[0]))
 #endif
@@ -31,6 +31,9 @@
 #ifndef ANDROID_ASTL_ALGORITHM__
 #error "Wrong header included!!"
 #endif
+#include <list>
+#include <string>
+#include <vector>
 #include "common.h"
 
 namespace android {
@@ -114,6 +117,115 @@ bool testFill_N()
     return true;
 }
 
+// 16 bytes, trivial assignment: filled by the 128 bit kernel.
+struct Quad {
+    int a, b, c, d;
+};
+
+bool operator==(const Quad& lhs, const Quad& rhs) {
+    return lhs.a == rhs.a && lhs.b == rhs.b && lhs.c == rhs.c && lhs.d == rhs.d;
+}
+
+// Fill ranges of various sizes and alignments of a guarded buffer.
+template<typename _T>
+bool checkFillWide(const _T& zero, const _T& value) {
+    const size_t kSize = 600;
+    static _T buffer[kSize];
+    const size_t counts[] = {0, 1, 3, 4, 5, 15, 16, 17, 33, 64, 100, 257, 500};
+    for (size_t c = 0; c < ARRAYSIZE(counts); ++c) {
+        for (size_t offset = 0; offset < 8; ++offset) {
+            const size_t n = counts[c];
+            std::fill(buffer, buffer + kSize, zero);
+            if (offset % 2 == 0) {
+                std::fill(buffer + offset, buffer + offset + n, value);
+            } else {
+                EXPECT_TRUE(std::fill_n(buffer + offset, n, value) ==
+                            buffer + offset + n);
+            }
+            for (size_t i = 0; i < kSize; ++i) {
+                const bool in_range = i >= offset && i < offset + n;
+                EXPECT_TRUE(buffer[i] == (in_range ? value : zero));
+            }
+        }
+    }
+    return true;
+}
+
+bool testFillWide()
+{
+    EXPECT_TRUE(checkFillWide<short>(0, -2));
+    EXPECT_TRUE(checkFillWide<int>(0, 0x12345678));
+    EXPECT_TRUE(checkFillWide<float>(0.0f, -1.5f));
+    EXPECT_TRUE(checkFillWide<double>(0.0, 3.25));
+    EXPECT_TRUE(checkFillWide<long long>(0, 0x123456789abcdefLL));
+    EXPECT_TRUE(checkFillWide<bool>(false, true));
+    const Quad zero = {0, 0, 0, 0};
+    const Quad quad = {1, 2, 3, 4};
+    EXPECT_TRUE(checkFillWide<Quad>(zero, quad));
+
+    // The value is in the range.
+    int array[100];
+    for (int i = 0; i < 100; ++i) {
+        array[i] = i;
+    }
+    std::fill(array, array + 100, array[50]);
+    EXPECT_TRUE(std::count(array, array + 100, 50) == 100);
+
+    // Large enough to use non temporal stores, with an unaligned end.
+    const size_t n = 3 * 1024 * 1024 + 3;
+    std::vector<unsigned int> large(n + 1, 0);
+    std::fill(&large[1], &large[1] + n - 1, 7u);
+    EXPECT_TRUE(large[0] == 0 && large[n - 1] == 7 && large[n] == 0);
+    EXPECT_TRUE(std::count(large.begin(), large.end(), 7u) ==
+                static_cast<ptrdiff_t>(n - 1));
+    return true;
+}
+
+bool testFillIterators()
+{
+    // Vector and string iterators are unwrapped: memset path.
+    std::vector<char> chars(100, 'a');
+    std::fill(chars.begin() + 1, chars.end() - 1, 'b');
+    EXPECT_TRUE(chars[0] == 'a' && chars[1] == 'b');
+    EXPECT_TRUE(chars[98] == 'b' && chars[99] == 'a');
+    std::vector<char>::iterator it = std::fill_n(chars.begin(), 10, 'c');
+    EXPECT_TRUE(it == chars.begin() + 10);
+    EXPECT_TRUE(chars[9] == 'c' && chars[10] == 'b');
+
+    std::string str(200, ' ');
+    std::fill(str.begin() + 100, str.end(), 'x');
+    EXPECT_TRUE(str[99] == ' ' && str[100] == 'x' && str[199] == 'x');
+    EXPECT_TRUE(std::fill_n(str.begin(), 3, 'y') == str.begin() + 3);
+    EXPECT_TRUE(str[2] == 'y' && str[3] == ' ');
+
+    // Value converted to the element type.
+    std::vector<double> doubles(50, 0.0);
+    std::fill(doubles.begin(), doubles.end(), 3);
+    EXPECT_TRUE(doubles[0] == 3.0 && doubles[49] == 3.0);
+    std::fill_n(doubles.begin(), 0, 1);
+    std::fill_n(doubles.begin(), -1, 1);
+    EXPECT_TRUE(doubles[0] == 3.0);
+
+    // Bidirectional iterators.
+    std::list<int> lst;
+    for (int i = 0; i < 5; ++i) {
+        lst.push_back(i);
+    }
+    std::fill(lst.begin(), lst.end(), 7);
+    EXPECT_TRUE(std::count(lst.begin(), lst.end(), 7) == 5);
+    std::list<int>::iterator pos = std::fill_n(lst.begin(), 2, 8);
+    EXPECT_TRUE(*pos == 7);
+    EXPECT_TRUE(lst.front() == 8);
+
+    // Non POD values.
+    std::vector<std::string> strings(30, std::string("a"));
+    std::fill(strings.begin() + 10, strings.end(), std::string("b"));
+    EXPECT_TRUE(strings[9] == "a" && strings[10] == "b" && strings[29] == "b");
+    std::fill(strings.begin(), strings.end(), strings[0]);
+    EXPECT_TRUE(std::count(strings.begin(), strings.end(), "a") == 30);
+    return true;
+}
+
 struct Left1 { };
 struct Right1 { };
 bool operator==(const Left1&, const Right1&) {return true;}
@@ -131,6 +243,128 @@ bool testEqual()
 
     EXPECT_TRUE(std::equal(&left1, &left1, &right1));
     EXPECT_TRUE(std::equal(&left2, &left2, &right2, predicate));
+
+    // memcmp: integral types, pointers, wrapper iterators.
+    const int ints[] = {1, 2, 3, 4};
+    int other[] = {1, 2, 3, 5};
+    EXPECT_TRUE(std::equal(ints, ints + 3, other));
+    EXPECT_FALSE(std::equal(ints, ints + 4, other));
+    EXPECT_TRUE(std::equal(ints, ints, static_cast<int*>(NULL)));
+    std::vector<int> vec(ints, ints + 4);
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), ints));
+    EXPECT_FALSE(std::equal(vec.begin(), vec.end(), other));
+
+    const char *ptrs[] = {"a", "b"};
+    const char *const same[] = {ptrs[0], ptrs[1]};
+    EXPECT_TRUE(std::equal(ptrs, ptrs + 2, same));
+
+    // Floating point: operator== is used.
+    const double zeros[] = {0.0, 1.0};
+    const double negative_zeros[] = {-0.0, 1.0};
+    EXPECT_TRUE(std::equal(zeros, zeros + 2, negative_zeros));
+
+    // Input iterators only need operator!=.
+    std::list<int> lst;
+    lst.push_back(1);
+    lst.push_back(2);
+    EXPECT_TRUE(std::equal(lst.begin(), lst.end(), ints));
+    EXPECT_FALSE(std::equal(lst.begin(), lst.end(), ints + 1));
+    return true;
+}
+
+bool testMismatch()
+{
+    // Mismatches inside and across memcmp blocks.
+    const int n = 1000;
+    static unsigned char bytes1[n];
+    static unsigned char bytes2[n];
+    static long long longs1[n];
+    static long long longs2[n];
+    for (int i = 0; i < n; ++i) {
+        bytes1[i] = bytes2[i] = static_cast<unsigned char>(i);
+        longs1[i] = longs2[i] = i;
+    }
+    std::pair<unsigned char*, unsigned char*> res =
+            std::mismatch(bytes1, bytes1 + n, bytes2);
+    EXPECT_TRUE(res.first == bytes1 + n);
+    EXPECT_TRUE(res.second == bytes2 + n);
+
+    const int positions[] = {0, 1, 255, 256, 257, 511, n - 1};
+    for (size_t i = 0; i < ARRAYSIZE(positions); ++i) {
+        const int pos = positions[i];
+        bytes2[pos] = 0xaa ^ bytes1[pos];
+        longs2[pos] = -1;
+        res = std::mismatch(bytes1, bytes1 + n, bytes2);
+        EXPECT_TRUE(res.first == bytes1 + pos);
+        EXPECT_TRUE(res.second == bytes2 + pos);
+        std::pair<long long*, long long*> res_longs =
+                std::mismatch(longs1, longs1 + n, longs2);
+        EXPECT_TRUE(res_longs.first == longs1 + pos);
+        EXPECT_TRUE(res_longs.second == longs2 + pos);
+        bytes2[pos] = bytes1[pos];
+        longs2[pos] = longs1[pos];
+    }
+
+    // Wrapper iterators are returned.
+    const int ints[] = {1, 2, 3, 4};
+    const int other[] = {1, 2, 0, 4};
+    std::vector<int> vec(ints, ints + 4);
+    std::pair<std::vector<int>::iterator, const int*> res_vec =
+            std::mismatch(vec.begin(), vec.end(), other);
+    EXPECT_TRUE(res_vec.first == vec.begin() + 2);
+    EXPECT_TRUE(res_vec.second == other + 2);
+
+    // Generic version and predicate.
+    std::string strings[] = {"a", "b", "c"};
+    std::string others[] = {"a", "b", "d"};
+    std::pair<std::string*, std::string*> res_str =
+            std::mismatch(strings, strings + 3, others);
+    EXPECT_TRUE(res_str.first == strings + 2);
+    res_str = std::mismatch(strings, strings + 3, others,
+                            std::equal_to<std::string>());
+    EXPECT_TRUE(res_str.second == others + 2);
+    return true;
+}
+
+bool testLexicographicalCompare()
+{
+    const unsigned char abc[] = {'a', 'b', 'c'};
+    const unsigned char abd[] = {'a', 'b', 'd'};
+    const unsigned char high[] = {0xff};
+    EXPECT_TRUE(std::lexicographical_compare(abc, abc + 3, abd, abd + 3));
+    EXPECT_FALSE(std::lexicographical_compare(abd, abd + 3, abc, abc + 3));
+    EXPECT_FALSE(std::lexicographical_compare(abc, abc + 3, abc, abc + 3));
+    // Prefix.
+    EXPECT_TRUE(std::lexicographical_compare(abc, abc + 2, abc, abc + 3));
+    EXPECT_FALSE(std::lexicographical_compare(abc, abc + 3, abc, abc + 2));
+    EXPECT_TRUE(std::lexicographical_compare(abc, abc, abc, abc + 1));
+    EXPECT_FALSE(std::lexicographical_compare(abc, abc, abc, abc));
+    EXPECT_TRUE(std::lexicographical_compare(abc, abc + 3, high, high + 1));
+
+    // Signed: -1 < 1 (memcmp would say otherwise).
+    const signed char minus[] = {-1};
+    const signed char plus[] = {1};
+    EXPECT_TRUE(std::lexicographical_compare(minus, minus + 1, plus, plus + 1));
+    const char cminus[] = {static_cast<char>(-1)};
+    const char cplus[] = {1};
+    EXPECT_TRUE(std::lexicographical_compare(cminus, cminus + 1,
+                                             cplus, cplus + 1) ==
+                (static_cast<char>(-1) < 1));
+
+    const int ints[] = {-5, 2, 3};
+    const int other[] = {1, 2, 3};
+    std::vector<int> vec(ints, ints + 3);
+    EXPECT_TRUE(std::lexicographical_compare(vec.begin(), vec.end(),
+                                             other, other + 3));
+    EXPECT_FALSE(std::lexicographical_compare(vec.begin(), vec.end(),
+                                              other, other + 3,
+                                              std::greater<int>()));
+
+    std::list<int> lst;
+    lst.push_back(1);
+    lst.push_back(2);
+    EXPECT_TRUE(std::lexicographical_compare(lst.begin(), lst.end(),
+                                             other, other + 3));
     return true;
 }
 
@@ -146,6 +380,578 @@ bool testCopy()
         EXPECT_TRUE(data[4] == 5);
         EXPECT_TRUE(data[5] == 6);
     }
+    {
+        // Wrapper iterators, POD: memmove between the vectors.
+        const int data[] = {1,2,3,4,5,6};
+        std::vector<int> src(data, data + 6);
+        std::vector<int> dest(data, data + 6);
+        std::vector<int>::iterator res =
+                std::copy(src.begin() + 1, src.end(), dest.begin());
+        EXPECT_TRUE(res == dest.begin() + 5);
+        EXPECT_TRUE(dest[0] == 2);
+        EXPECT_TRUE(dest[4] == 6);
+        EXPECT_TRUE(dest[5] == 6);
+
+        // Empty range.
+        res = std::copy(src.begin(), src.begin(), dest.begin() + 2);
+        EXPECT_TRUE(res == dest.begin() + 2);
+        int *const p = std::copy(data, data, static_cast<int*>(NULL));
+        EXPECT_TRUE(p == NULL);
+    }
+    {
+        // Non POD elements are assigned one by one.
+        std::string data[] = {"a", "b", "c"};
+        std::string *res = std::copy(data + 1, data + 3, data);
+        EXPECT_TRUE(res == data + 2);
+        EXPECT_TRUE(data[0] == "b");
+        EXPECT_TRUE(data[1] == "c");
+        EXPECT_TRUE(data[2] == "c");
+    }
+    return true;
+}
+
+bool testCopyBackward()
+{
+    {
+        // Overlapping ranges, shift to the right.
+        int data[] = {1,2,3,4,5,6};
+        int *res = std::copy_backward(data, data + 4, data + 6);
+        EXPECT_TRUE(res == data + 2);
+        EXPECT_TRUE(data[0] == 1);
+        EXPECT_TRUE(data[1] == 2);
+        EXPECT_TRUE(data[2] == 1);
+        EXPECT_TRUE(data[3] == 2);
+        EXPECT_TRUE(data[4] == 3);
+        EXPECT_TRUE(data[5] == 4);
+    }
+    {
+        const int data[] = {1,2,3,4,5,6};
+        std::vector<int> vec(data, data + 6);
+        std::vector<int>::iterator res =
+                std::copy_backward(vec.begin(), vec.begin() + 3, vec.end());
+        EXPECT_TRUE(res == vec.begin() + 3);
+        EXPECT_TRUE(vec[3] == 1);
+        EXPECT_TRUE(vec[5] == 3);
+        res = std::move_backward(vec.begin(), vec.begin(), vec.end());
+        EXPECT_TRUE(res == vec.end());
+    }
+    {
+        std::string data[] = {"a", "b", "c"};
+        std::string *res = std::copy_backward(data, data + 2, data + 3);
+        EXPECT_TRUE(res == data + 1);
+        EXPECT_TRUE(data[0] == "a");
+        EXPECT_TRUE(data[1] == "a");
+        EXPECT_TRUE(data[2] == "b");
+    }
+    return true;
+}
+
+bool testMove()
+{
+    int data[] = {1,2,3,4,5,6};
+    int *res = std::move(data + 3, data + 6, data);
+    EXPECT_TRUE(res == data + 3);
+    EXPECT_TRUE(data[0] == 4);
+    EXPECT_TRUE(data[2] == 6);
+    EXPECT_TRUE(data[3] == 4);
+    return true;
+}
+
+// Check find and count on arrays of n elements of type _T, around
+// the vector sizes used by the SIMD kernels.
+template<typename _T>
+bool checkFindCount(int n) {
+    static _T data[300];
+    for (int i = 0; i < n; ++i) {
+        data[i] = static_cast<_T>(i % 7 + 1);
+    }
+    EXPECT_TRUE(std::find(data, data + n, _T(0)) == data + n);
+    EXPECT_TRUE(std::count(data, data + n, _T(0)) == 0);
+    // Every position of a single match.
+    for (int pos = 0; pos < n; ++pos) {
+        data[pos] = 0;
+        EXPECT_TRUE(std::find(data, data + n, _T(0)) == data + pos);
+        EXPECT_TRUE(std::count(data, data + n, _T(0)) == 1);
+        data[pos] = static_cast<_T>(pos % 7 + 1);
+    }
+    int expected = 0;
+    for (int i = 0; i < n; ++i) {
+        expected += i % 7 == 2;
+    }
+    EXPECT_TRUE(std::count(data, data + n, _T(3)) == expected);
+    // Unaligned start.
+    if (n > 3) {
+        EXPECT_TRUE(std::find(data + 1, data + n, _T(1)) == data + 7);
+    }
+    return true;
+}
+
+bool testFind()
+{
+    const int sizes[] = {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 300};
+    for (size_t i = 0; i < ARRAYSIZE(sizes); ++i) {
+        EXPECT_TRUE(checkFindCount<char>(sizes[i]));
+        EXPECT_TRUE(checkFindCount<unsigned char>(sizes[i]));
+        EXPECT_TRUE(checkFindCount<int>(sizes[i]));
+        EXPECT_TRUE(checkFindCount<unsigned int>(sizes[i]));
+        EXPECT_TRUE(checkFindCount<long long>(sizes[i]));
+        EXPECT_TRUE(checkFindCount<short>(sizes[i]));  // No kernel.
+    }
+
+    // Large counts: the per lane counters are flushed.
+    static unsigned char bytes[100000];
+    memset(bytes, 'x', sizeof(bytes));
+    EXPECT_TRUE(std::count(bytes, bytes + sizeof(bytes), 'x') == 100000);
+
+    // Signed and negative values, out of range values.
+    const char text[] = "abc\xff";
+    EXPECT_TRUE(std::find(text, text + 4, '\xff') == text + 3);
+    EXPECT_TRUE(std::find(text, text + 4, 0x1ff) == text + 4);
+    EXPECT_TRUE(std::count(text, text + 4, 0x161) == 0);
+    const unsigned char utext[] = {1, 0xff};
+    EXPECT_TRUE(std::find(utext, utext + 2, -1) == utext + 2);
+    EXPECT_TRUE(std::find(utext, utext + 2, 255) == utext + 1);
+    const long long longs[] = {5, -1, 1LL << 40};
+    EXPECT_TRUE(std::find(longs, longs + 3, -1) == longs + 1);
+    EXPECT_TRUE(std::find(longs, longs + 3, 1LL << 40) == longs + 2);
+    EXPECT_TRUE(std::find(longs, longs + 3, 0) == longs + 3);
+
+    // Wrapper iterators.
+    const int ints[] = {1, 2, 3, 2};
+    std::vector<int> vec(ints, ints + 4);
+    EXPECT_TRUE(std::find(vec.begin(), vec.end(), 3) == vec.begin() + 2);
+    EXPECT_TRUE(std::count(vec.begin(), vec.end(), 2) == 2);
+    std::vector<int> empty;
+    EXPECT_TRUE(std::find(empty.begin(), empty.end(), 3) == empty.end());
+
+    // Generic versions.
+    std::list<std::string> lst;
+    lst.push_back("a");
+    lst.push_back("b");
+    lst.push_back("a");
+    EXPECT_TRUE(std::find(lst.begin(), lst.end(), "b") == ++lst.begin());
+    EXPECT_TRUE(std::find(lst.begin(), lst.end(), "c") == lst.end());
+    EXPECT_TRUE(std::count(lst.begin(), lst.end(), "a") == 2);
+    const double doubles[] = {1.0, 2.5};
+    EXPECT_TRUE(std::find(doubles, doubles + 2, 2.5) == doubles + 1);
+    return true;
+}
+
+bool isEven(int i) { return i % 2 == 0; }
+
+bool testFindIf()
+{
+    const int ints[] = {1, 3, 4, 6};
+    EXPECT_TRUE(std::find_if(ints, ints + 4, isEven) == ints + 2);
+    EXPECT_TRUE(std::find_if(ints, ints + 2, isEven) == ints + 2);
+    EXPECT_TRUE(std::count_if(ints, ints + 4, isEven) == 2);
+    std::list<int> lst;
+    EXPECT_TRUE(std::find_if(lst.begin(), lst.end(), isEven) == lst.end());
+    EXPECT_TRUE(std::count_if(lst.begin(), lst.end(), isEven) == 0);
+    return true;
+}
+
+bool testSearch()
+{
+    const char text[] = "abababcabcdabcde";
+    const char *const end = text + sizeof(text) - 1;
+    const char pattern[] = "abcd";
+    EXPECT_TRUE(std::search(text, end, pattern, pattern + 4) == text + 7);
+    EXPECT_TRUE(std::search(text, end, pattern, pattern + 3) == text + 4);
+    EXPECT_TRUE(std::search(text, end, pattern, pattern) == text);
+    EXPECT_TRUE(std::search(text, text + 10, pattern, pattern + 4) ==
+                text + 10);
+    EXPECT_TRUE(std::search(text, text + 2, pattern, pattern + 4) == text + 2);
+    // Match at the very end.
+    const char tail[] = "cde";
+    EXPECT_TRUE(std::search(text, end, tail, tail + 3) == end - 3);
+
+    const long long longs[] = {1, 2, 1, 2, 3};
+    const long long sub[] = {2, 3};
+    EXPECT_TRUE(std::search(longs, longs + 5, sub, sub + 2) == longs + 3);
+    std::vector<long long> vec(longs, longs + 5);
+    EXPECT_TRUE(std::search(vec.begin(), vec.end(), sub, sub + 2) ==
+                vec.begin() + 3);
+
+    // Generic versions.
+    std::list<int> lst;
+    lst.push_back(1);
+    lst.push_back(2);
+    lst.push_back(3);
+    const int ints[] = {2, 3};
+    EXPECT_TRUE(std::search(lst.begin(), lst.end(), ints, ints + 2) ==
+                ++lst.begin());
+    EXPECT_TRUE(std::search(lst.begin(), lst.end(), ints, ints + 2,
+                            std::equal_to<int>()) == ++lst.begin());
+    const short shorts[] = {1, 2, 3};
+    EXPECT_TRUE(std::search(shorts, shorts + 3, shorts + 2, shorts + 3) ==
+                shorts + 2);
+    return true;
+}
+
+// Reference: linear scan.
+int countLess(const int *data, int n, int val) {
+    int count = 0;
+    while (count < n && data[count] < val) {
+        ++count;
+    }
+    return count;
+}
+
+bool testLowerUpperBound()
+{
+    // Every size up to 64 with duplicates, for values before, between
+    // and after the elements.
+    static int data[64];
+    for (int n = 0; n <= 64; ++n) {
+        for (int i = 0; i < n; ++i) {
+            data[i] = 2 * (i / 3);  // 0 0 0 2 2 2...
+        }
+        for (int val = -1; val <= n; ++val) {
+            const int lower = countLess(data, n, val);
+            const int upper = countLess(data, n, val + 1);
+            EXPECT_TRUE(std::lower_bound(data, data + n, val) == data + lower);
+            EXPECT_TRUE(std::upper_bound(data, data + n, val) == data + upper);
+            std::pair<int*, int*> range = std::equal_range(data, data + n, val);
+            EXPECT_TRUE(range.first == data + lower);
+            EXPECT_TRUE(range.second == data + upper);
+            EXPECT_TRUE(std::binary_search(data, data + n, val) ==
+                        (lower != upper));
+        }
+    }
+
+    // Heterogeneous comparison: no conversion of val.
+    const int ints[] = {1, 2, 3};
+    EXPECT_TRUE(std::lower_bound(ints, ints + 3, 2.5) == ints + 2);
+    EXPECT_TRUE(std::upper_bound(ints, ints + 3, 1.5) == ints + 1);
+    EXPECT_FALSE(std::binary_search(ints, ints + 3, 2.5));
+
+    // Comparator, wrapper iterators.
+    const int reversed[] = {9, 7, 7, 3};
+    std::vector<int> vec(reversed, reversed + 4);
+    std::greater<int> greater;
+    EXPECT_TRUE(std::lower_bound(vec.begin(), vec.end(), 7, greater) ==
+                vec.begin() + 1);
+    EXPECT_TRUE(std::upper_bound(vec.begin(), vec.end(), 7, greater) ==
+                vec.begin() + 3);
+    std::pair<std::vector<int>::iterator, std::vector<int>::iterator> range =
+            std::equal_range(vec.begin(), vec.end(), 7, greater);
+    EXPECT_TRUE(range.first == vec.begin() + 1);
+    EXPECT_TRUE(range.second == vec.begin() + 3);
+    EXPECT_TRUE(std::binary_search(vec.begin(), vec.end(), 3, greater));
+    EXPECT_FALSE(std::binary_search(vec.begin(), vec.end(), 4, greater));
+    std::vector<int> empty;
+    EXPECT_TRUE(std::lower_bound(empty.begin(), empty.end(), 1) == empty.end());
+    EXPECT_FALSE(std::binary_search(empty.begin(), empty.end(), 1));
+
+    // Non POD elements and forward iterators.
+    std::string strings[] = {"a", "b", "b", "c"};
+    EXPECT_TRUE(std::lower_bound(strings, strings + 4, "b") == strings + 1);
+    EXPECT_TRUE(std::upper_bound(strings, strings + 4, "b") == strings + 3);
+    std::pair<std::string*, std::string*> str_range =
+            std::equal_range(strings, strings + 4, std::string("b"));
+    EXPECT_TRUE(str_range.first == strings + 1);
+    EXPECT_TRUE(str_range.second == strings + 3);
+    EXPECT_TRUE(std::binary_search(strings, strings + 4, std::string("c")));
+
+    std::list<int> lst;
+    lst.push_back(1);
+    lst.push_back(3);
+    lst.push_back(3);
+    lst.push_back(5);
+    std::list<int>::iterator it = std::lower_bound(lst.begin(), lst.end(), 3);
+    EXPECT_TRUE(it == ++lst.begin());
+    std::pair<std::list<int>::iterator, std::list<int>::iterator> lst_range =
+            std::equal_range(lst.begin(), lst.end(), 3);
+    EXPECT_TRUE(lst_range.first == ++lst.begin());
+    EXPECT_TRUE(lst_range.second == --lst.end());
+    EXPECT_TRUE(std::upper_bound(lst.begin(), lst.end(), 5) == lst.end());
+    EXPECT_FALSE(std::binary_search(lst.begin(), lst.end(), 4));
+    return true;
+}
+
+bool testHeap()
+{
+    const int n = 1000;
+    static int data[n];
+    unsigned int seed = 7;
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = (seed >> 16) % 100;
+    }
+    std::make_heap(data, data + n);
+    EXPECT_TRUE(std::is_heap(data, data + n));
+
+    // Pop everything: non increasing order.
+    for (int len = n; len > 1; --len) {
+        const int top = data[0];
+        std::pop_heap(data, data + len);
+        EXPECT_TRUE(data[len - 1] == top);
+        EXPECT_TRUE(std::is_heap(data, data + len - 1));
+        if (len < n) {
+            EXPECT_TRUE(data[len - 1] <= data[len]);
+        }
+    }
+
+    // Push one element at a time.
+    for (int len = 1; len <= n; ++len) {
+        std::push_heap(data, data + len);
+        EXPECT_TRUE(std::is_heap(data, data + len));
+    }
+    std::sort_heap(data, data + n);
+    for (int i = 1; i < n; ++i) {
+        EXPECT_TRUE(data[i - 1] <= data[i]);
+    }
+    EXPECT_FALSE(std::is_heap(data, data + n));
+
+    // Comparator, wrapper iterators: a min heap.
+    const int ints[] = {5, 3, 8, 1, 9, 2};
+    std::vector<int> vec(ints, ints + 6);
+    std::greater<int> greater;
+    std::make_heap(vec.begin(), vec.end(), greater);
+    EXPECT_TRUE(std::is_heap(vec.begin(), vec.end(), greater));
+    EXPECT_TRUE(vec[0] == 1);
+    std::pop_heap(vec.begin(), vec.end(), greater);
+    EXPECT_TRUE(vec[5] == 1);
+    EXPECT_TRUE(vec[0] == 2);
+    vec[5] = 0;
+    std::push_heap(vec.begin(), vec.end(), greater);
+    EXPECT_TRUE(vec[0] == 0);
+    std::sort_heap(vec.begin(), vec.end(), greater);
+    EXPECT_TRUE(vec[0] == 9);
+    EXPECT_TRUE(vec[5] == 0);
+
+    // Empty and single element ranges.
+    std::make_heap(data, data);
+    std::push_heap(data, data + 1);
+    std::pop_heap(data, data + 1);
+    EXPECT_TRUE(std::is_heap(data, data));
+
+    // Non POD elements.
+    std::string strings[] = {"b", "d", "a", "c"};
+    std::make_heap(strings, strings + 4);
+    EXPECT_TRUE(strings[0] == "d");
+    std::sort_heap(strings, strings + 4);
+    EXPECT_TRUE(strings[0] == "a");
+    EXPECT_TRUE(strings[3] == "d");
+    return true;
+}
+
+// Inputs which defeat naive pivot choices.
+enum Pattern { kRandom, kSorted, kReversed, kEqual, kOrganPipe, kFewValues };
+const int kNumPatterns = 6;
+
+void generate(int *data, int n, Pattern pattern, unsigned int seed) {
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 1103515245 + 12345;
+        switch (pattern) {
+            case kRandom:    data[i] = static_cast<int>(seed >> 1); break;
+            case kSorted:    data[i] = i; break;
+            case kReversed:  data[i] = n - i; break;
+            case kEqual:     data[i] = 7; break;
+            case kOrganPipe: data[i] = i < n / 2 ? i : n - i; break;
+            case kFewValues: data[i] = (seed >> 8) % 4; break;
+        }
+    }
+}
+
+// @return true if [first, last) is sorted and a permutation of the
+// values in original (checked with a sum and a xor).
+bool isSortedPermutation(const int *first, const int *last,
+                         const int *original) {
+    long long sum = 0;
+    int x = 0;
+    for (const int *i = first; i != last; ++i, ++original) {
+        if (i != first && *i < *(i - 1)) {
+            return false;
+        }
+        sum += *i - *original;
+        x ^= *i ^ *original;
+    }
+    return sum == 0 && x == 0;
+}
+
+bool testSort()
+{
+    const int kSizes[] = {0, 1, 2, 3, 15, 16, 17, 100, 1000, 100000};
+    static int original[100000];
+    for (size_t s = 0; s < ARRAYSIZE(kSizes); ++s) {
+        const int n = kSizes[s];
+        for (int p = 0; p < kNumPatterns; ++p) {
+            generate(original, n, static_cast<Pattern>(p), n);
+            std::vector<int> data(original, original + n);
+            std::sort(data.begin(), data.end());  // wrapper iterators
+            EXPECT_TRUE(isSortedPermutation(&data[0], &data[0] + n, original));
+        }
+    }
+
+    // Comparator and raw pointers.
+    int array[] = {5, 1, 4, 2, 3};
+    std::sort(array, array + 5, std::greater<int>());
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(array[i] == 5 - i);
+    }
+
+    // Non POD.
+    std::string strings[] = {"pear", "apple", "fig", "banana", "kiwi"};
+    std::sort(strings, strings + 5);
+    EXPECT_TRUE(strings[0] == "fig");   // string orders by length first
+    EXPECT_TRUE(strings[4] == "banana");
+    return true;
+}
+
+struct Record {
+    int mKey;
+    int mOrder;
+};
+
+struct ByKey {
+    bool operator()(const Record& a, const Record& b) const { return a.mKey < b.mKey; }
+};
+
+bool testStableSort()
+{
+    const int kSizes[] = {0, 1, 10, 15, 16, 1000, 100000};
+    std::vector<Record> records;
+    for (size_t s = 0; s < ARRAYSIZE(kSizes); ++s) {
+        const int n = kSizes[s];
+        records.clear();
+        unsigned int seed = n;
+        for (int i = 0; i < n; ++i) {
+            seed = seed * 1103515245 + 12345;
+            Record r = { static_cast<int>((seed >> 8) % 100), i };
+            records.push_back(r);
+        }
+        std::stable_sort(records.begin(), records.end(), ByKey());
+        for (int i = 1; i < n; ++i) {
+            EXPECT_TRUE(records[i - 1].mKey < records[i].mKey ||
+                        (records[i - 1].mKey == records[i].mKey &&
+                         records[i - 1].mOrder < records[i].mOrder));
+        }
+    }
+
+    // Fallback used when the buffer cannot be allocated.
+    records.clear();
+    for (int i = 0; i < 5000; ++i) {
+        Record r = { (i * 7919) % 13, i };
+        records.push_back(r);
+    }
+    std::__inplace_stable_sort(&records[0], &records[0] + 5000, ByKey());
+    for (int i = 1; i < 5000; ++i) {
+        EXPECT_TRUE(records[i - 1].mKey < records[i].mKey ||
+                    (records[i - 1].mKey == records[i].mKey &&
+                     records[i - 1].mOrder < records[i].mOrder));
+    }
+
+    std::string strings[] = {"d", "c", "bb", "a", "aa"};
+    std::stable_sort(strings, strings + 5);
+    EXPECT_TRUE(strings[0] == "a" && strings[2] == "d" && strings[4] == "bb");
+    return true;
+}
+
+bool testPartialSort()
+{
+    int original[1000];
+    int data[1000];
+    generate(original, 1000, kRandom, 42);
+    memcpy(data, original, sizeof(data));
+
+    std::partial_sort(data, data + 10, data + 1000);
+    int sorted[1000];
+    memcpy(sorted, original, sizeof(sorted));
+    std::sort(sorted, sorted + 1000);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(data[i] == sorted[i]);
+    }
+    for (int i = 10; i < 1000; ++i) {
+        EXPECT_TRUE(data[i] >= data[9]);
+    }
+
+    std::partial_sort(data, data + 1000, data + 1000, std::greater<int>());
+    EXPECT_TRUE(data[0] == sorted[999] && data[999] == sorted[0]);
+    return true;
+}
+
+bool testNthElement()
+{
+    const int n = 10001;
+    static int original[n];
+    static int sorted[n];
+    for (int p = 0; p < kNumPatterns; ++p) {
+        generate(original, n, static_cast<Pattern>(p), p);
+        memcpy(sorted, original, sizeof(sorted));
+        std::sort(sorted, sorted + n);
+        const int positions[] = {0, 1, n / 2, n - 2, n - 1};
+        for (size_t k = 0; k < ARRAYSIZE(positions); ++k) {
+            std::vector<int> data(original, original + n);
+            const int nth = positions[k];
+            std::nth_element(data.begin(), data.begin() + nth, data.end());
+            EXPECT_TRUE(data[nth] == sorted[nth]);
+            for (int i = 0; i < nth; ++i) {
+                EXPECT_TRUE(data[i] <= data[nth]);
+            }
+            for (int i = nth + 1; i < n; ++i) {
+                EXPECT_TRUE(data[i] >= data[nth]);
+            }
+        }
+    }
+    return true;
+}
+
+struct Twice {
+    int operator()(int x) const { return 2 * x; }
+};
+
+struct Sum {
+    Sum(): mTotal(0) { }
+    void operator()(int x) { mTotal += x; }
+    int mTotal;
+};
+
+bool testForEachTransform()
+{
+    int array[] = {1, 2, 3, 4};
+    EXPECT_TRUE(std::for_each(array, array + 4, Sum()).mTotal == 10);
+    EXPECT_TRUE(std::for_each(array, array, Sum()).mTotal == 0);
+
+    std::vector<int> out(4, 0);
+    EXPECT_TRUE(std::transform(array, array + 4, out.begin(), Twice()) ==
+                out.end());
+    EXPECT_TRUE(out[0] == 2 && out[3] == 8);
+    EXPECT_TRUE(std::transform(array, array + 4, out.begin(), array,
+                               std::minus<int>()) == array + 4);
+    EXPECT_TRUE(array[0] == -1 && array[3] == -4);
+    return true;
+}
+
+bool testMerge()
+{
+    const int a[] = {1, 3, 3, 7};
+    const int b[] = {0, 3, 8, 9, 10};
+    int out[9];
+    EXPECT_TRUE(std::merge(a, a + 4, b, b + 5, out) == out + 9);
+    const int expected[] = {0, 1, 3, 3, 3, 7, 8, 9, 10};
+    EXPECT_TRUE(std::equal(out, out + 9, expected));
+
+    EXPECT_TRUE(std::merge(a, a, b, b + 2, out) == out + 2);
+    EXPECT_TRUE(out[0] == 0 && out[1] == 3);
+
+    // Stable: equivalent elements of the first range come first.
+    const Record lhs[] = {{1, 0}, {2, 2}};
+    const Record rhs[] = {{1, 1}, {2, 3}};
+    Record res[4];
+    std::merge(lhs, lhs + 2, rhs, rhs + 2, res, ByKey());
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(res[i].mOrder == i);
+    }
+
+    const int c[] = {10, 7, 3};
+    const int d[] = {9, 8, 3, 1};
+    EXPECT_TRUE(std::merge(c, c + 3, d, d + 4, out, std::greater<int>()) ==
+                out + 7);
+    for (int i = 1; i < 7; ++i) {
+        EXPECT_TRUE(out[i - 1] >= out[i]);
+    }
     return true;
 }
 
@@ -158,7 +964,24 @@ int main(int argc, char **argv)
     FAIL_UNLESS(testMax);
     FAIL_UNLESS(testFill);
     FAIL_UNLESS(testFill_N);
+    FAIL_UNLESS(testFillWide);
+    FAIL_UNLESS(testFillIterators);
     FAIL_UNLESS(testEqual);
+    FAIL_UNLESS(testMismatch);
+    FAIL_UNLESS(testLexicographicalCompare);
+    FAIL_UNLESS(testFind);
+    FAIL_UNLESS(testFindIf);
+    FAIL_UNLESS(testSearch);
+    FAIL_UNLESS(testLowerUpperBound);
     FAIL_UNLESS(testCopy);
+    FAIL_UNLESS(testCopyBackward);
+    FAIL_UNLESS(testMove);
+    FAIL_UNLESS(testSort);
+    FAIL_UNLESS(testStableSort);
+    FAIL_UNLESS(testPartialSort);
+    FAIL_UNLESS(testNthElement);
+    FAIL_UNLESS(testForEachTransform);
+    FAIL_UNLESS(testMerge);
+    FAIL_UNLESS(testHeap);
     return kPassed;
 }
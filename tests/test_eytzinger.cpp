@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+
+#include "../include/eytzinger.h"
+#ifndef ANDROID_ASTL_EYTZINGER_H__
+#error "Wrong header included!!"
+#endif
+#include <functional>
+#include <vector>
+#include "common.h"
+
+namespace android {
+
+bool testLayout()
+{
+    const int sorted[] = {1, 2, 3, 4, 5, 6, 7};
+    int tree[8] = {-1};
+    eytzinger_layout(sorted, 7, tree);
+    EXPECT_TRUE(tree[0] == -1);
+    EXPECT_TRUE(tree[1] == 4);
+    EXPECT_TRUE(tree[2] == 2);
+    EXPECT_TRUE(tree[3] == 6);
+    EXPECT_TRUE(tree[4] == 1);
+    EXPECT_TRUE(tree[5] == 3);
+    EXPECT_TRUE(tree[6] == 5);
+    EXPECT_TRUE(tree[7] == 7);
+
+    eytzinger_layout(sorted, 0, tree);  // No-op.
+    EXPECT_TRUE(tree[1] == 4);
+    return true;
+}
+
+// Compare with std::lower_bound on every size up to 100, with
+// duplicates, for values before, between and after the elements.
+bool testLowerBound()
+{
+    static int sorted[100];
+    static int tree[101];
+    for (int n = 0; n <= 100; ++n) {
+        for (int i = 0; i < n; ++i) {
+            sorted[i] = 2 * (i / 2);  // 0 0 2 2 4 4...
+        }
+        eytzinger_layout(sorted, n, tree);
+        for (int val = -1; val <= n + 1; ++val) {
+            const int *expected = std::lower_bound(sorted, sorted + n, val);
+            const size_t k = eytzinger_lower_bound(tree, n, val);
+            if (expected == sorted + n) {
+                EXPECT_TRUE(k == 0);
+            } else {
+                EXPECT_TRUE(k >= 1 && k <= static_cast<size_t>(n));
+                EXPECT_TRUE(tree[k] == *expected);
+            }
+        }
+    }
+    return true;
+}
+
+bool testComparator()
+{
+    const int sorted[] = {9, 7, 5, 3, 1};
+    int tree[6];
+    eytzinger_layout(sorted, 5, tree);
+    size_t k = eytzinger_lower_bound(tree, 5, 4, std::greater<int>());
+    EXPECT_TRUE(tree[k] == 3);
+    k = eytzinger_lower_bound(tree, 5, 0, std::greater<int>());
+    EXPECT_TRUE(k == 0);
+
+    // Payloads laid out the same way.
+    const long long payloads[] = {90, 70, 50, 30, 10};
+    long long payload_tree[6];
+    eytzinger_layout(payloads, 5, payload_tree);
+    k = eytzinger_lower_bound(tree, 5, 7, std::greater<int>());
+    EXPECT_TRUE(payload_tree[k] == 70);
+    return true;
+}
+
+bool testLarge()
+{
+    const size_t n = 1000000;
+    std::vector<unsigned int> sorted;
+    for (size_t i = 0; i < n; ++i) {
+        sorted.push_back(i * 3);
+    }
+    std::vector<unsigned int> tree;
+    tree.resize(n + 1);
+    eytzinger_layout(&sorted[0], n, &tree[0]);
+    for (unsigned int val = 0; val < 3 * n + 3; val += 997) {
+        const size_t k = eytzinger_lower_bound(&tree[0], n, val);
+        if (val > 3 * (n - 1)) {
+            EXPECT_TRUE(k == 0);
+        } else {
+            EXPECT_TRUE(tree[k] == (val + 2) / 3 * 3);
+        }
+    }
+    return true;
+}
+
+}  // namespace android
+
+int main(int argc, char **argv)
+{
+    FAIL_UNLESS(testLayout);
+    FAIL_UNLESS(testLowerBound);
+    FAIL_UNLESS(testComparator);
+    FAIL_UNLESS(testLarge);
+    return kPassed;
+}
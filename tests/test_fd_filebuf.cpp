@@ -0,0 +1,191 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "../include/fd_filebuf.h"
+#ifndef ANDROID_ASTL_FD_FILEBUF__
+#error "Wrong header included!!"
+#endif
+#include "common.h"
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <pthread.h>
+#include <string>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace android {
+
+// @return The content of the file behind fd.
+std::string content(int fd) {
+    std::string result;
+    char buf[4096];
+    off_t offset = 0;
+    ssize_t len;
+    while ((len = pread(fd, buf, sizeof(buf), offset)) > 0) {
+        result.append(buf, len);
+        offset += len;
+    }
+    return result;
+}
+
+bool testBuffered() {
+    FILE *file = tmpfile();
+    const int fd = fileno(file);
+    {
+        fd_ofstream os(fd, 16);
+        EXPECT_TRUE(os.is_open());
+        EXPECT_TRUE(os.rdbuf()->buffer_size() == 16);
+
+        os << "hello " << 42;
+        EXPECT_TRUE(content(fd).empty());
+        os << std::flush;
+        EXPECT_TRUE(content(fd) == "hello 42");
+
+        // Does not fit: written along with the put area.
+        os << "abc" << "a longer string than the buffer";
+        EXPECT_TRUE(content(fd) == "hello 42abca longer string than the buffer");
+        for (int i = 0; i < 10; ++i) {
+            os << 'x';
+        }
+        EXPECT_TRUE(content(fd).size() == 42);
+        os << std::endl;
+        EXPECT_TRUE(content(fd).size() == 53);
+
+        // Resizing writes the put area out.
+        os << "yz";
+        EXPECT_TRUE(os.rdbuf()->set_buffer_size(1024));
+        EXPECT_TRUE(content(fd).size() == 55);
+        os << "end";
+    }
+    // Written by the destructor, fd is left open.
+    EXPECT_TRUE(content(fd).size() == 58);
+    EXPECT_TRUE(write(fd, "", 0) == 0);
+    fclose(file);
+    return true;
+}
+
+bool testUnbuffered() {
+    FILE *file = tmpfile();
+    const int fd = fileno(file);
+    fd_filebuf buf(fd, 0);
+    std::ostream os(&buf);
+    os << "abc" << 'd';
+    EXPECT_TRUE(content(fd) == "abcd");
+    EXPECT_TRUE(buf.pubsync() == 0);
+    fclose(file);
+    return true;
+}
+
+bool testOpen() {
+    fd_ofstream missing("/nonexistent/dir/file");
+    EXPECT_FALSE(missing.is_open());
+    missing << "dropped" << std::flush;
+
+    fd_ofstream null("/dev/null", true);
+    EXPECT_TRUE(null.is_open());
+    null << "to /dev/null";
+    EXPECT_TRUE(null.close());
+    EXPECT_FALSE(null.is_open());
+    return true;
+}
+
+// Drains a pipe slowly while the writer is interrupted by signals:
+// the writes are partial or fail with EINTR.
+const size_t kPipeTotal = 4 * 1024 * 1024;
+
+void *slowReader(void *arg) {
+    const int fd = *static_cast<int*>(arg);
+    std::string *data = new std::string;
+    char buf[1000];
+    ssize_t len;
+    while ((len = read(fd, buf, sizeof(buf))) != 0) {
+        if (len > 0) {
+            data->append(buf, len);
+        }
+    }
+    return data;
+}
+
+void onAlarm(int) { }
+
+bool testInterrupted() {
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onAlarm;  // No SA_RESTART.
+    sigaction(SIGALRM, &action, NULL);
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = 200;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_REAL, &timer, NULL);
+
+    int fds[2];
+    EXPECT_TRUE(pipe(fds) == 0);
+    pthread_t reader;
+    pthread_create(&reader, NULL, slowReader, &fds[0]);
+    std::string expected;
+    {
+        fd_filebuf buf(fds[1], 10000);
+        std::ostream os(&buf);
+        char token[20];
+        for (int i = 0; expected.size() < kPipeTotal; ++i) {
+            const int len = snprintf(token, sizeof(token), "%d ", i);
+            os.write(token, len);
+            expected.append(token, len);
+            if (i % 10000 == 0) {
+                const std::string large(100000, 'a' + i % 26);
+                os << large;
+                expected += large;
+            }
+        }
+    }
+    close(fds[1]);
+    void *data;
+    pthread_join(reader, &data);
+    timer.it_value.tv_usec = 0;
+    timer.it_interval.tv_usec = 0;
+    setitimer(ITIMER_REAL, &timer, NULL);
+    close(fds[0]);
+
+    std::string *received = static_cast<std::string*>(data);
+    EXPECT_TRUE(*received == expected);
+    delete received;
+    return true;
+}
+
+}  // namespace android
+
+int main(int argc, char **argv){
+    FAIL_UNLESS(testBuffered);
+    FAIL_UNLESS(testUnbuffered);
+    FAIL_UNLESS(testOpen);
+    FAIL_UNLESS(testInterrupted);
+    return kPassed;
+}
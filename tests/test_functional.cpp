@@ -32,6 +32,7 @@
 #error "Wrong header included!!"
 #endif
 
+#include <string>
 #include "common.h"
 
 
@@ -53,9 +54,61 @@ bool testInteger() {
     return true;
 }
 
+bool testHash() {
+    EXPECT_TRUE(std::hash<int>()(10) == std::hash<int>()(10));
+    EXPECT_TRUE(std::hash<int>()(10) != std::hash<int>()(11));
+    EXPECT_TRUE(std::hash<unsigned long long>()(1ULL << 40) !=
+                std::hash<unsigned long long>()(0));
+
+    int a, b;
+    EXPECT_TRUE(std::hash<int*>()(&a) != std::hash<int*>()(&b));
+
+    // Strings hash their content, not their address.
+    const std::string s1("hello world");
+    const std::string s2("hello world");
+    EXPECT_TRUE(std::hash<std::string>()(s1) == std::hash<std::string>()(s2));
+    EXPECT_TRUE(std::hash<std::string>()(s1) != std::hash<std::string>()("hello worle"));
+    EXPECT_TRUE(std::hash<std::string>()(std::string()) ==
+                android::hash_bytes("", 0));
+
+    char buffer[] = "hello world";
+    EXPECT_TRUE(std::hash<const char*>()(buffer) == std::hash<std::string>()(s1));
+    return true;
+}
+
+bool testHashBytes() {
+    // Every length and every byte position changes the hash. Covers
+    // the short (<= 16), medium and 48 bytes per step paths.
+    unsigned char data[300];
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        data[i] = static_cast<unsigned char>(i * 7);
+    }
+    size_t previous = android::hash_bytes(data, 0);
+    for (size_t len = 1; len <= sizeof(data); ++len) {
+        const size_t h = android::hash_bytes(data, len);
+        EXPECT_TRUE(h != previous);
+        previous = h;
+        for (size_t pos = 0; pos < len; pos += 5) {
+            data[pos] ^= 1;
+            EXPECT_TRUE(android::hash_bytes(data, len) != h);
+            data[pos] ^= 1;
+        }
+        EXPECT_TRUE(android::hash_bytes(data, len) == h);
+    }
+
+    // Unaligned input.
+    EXPECT_TRUE(android::hash_bytes(data + 1, 100) != android::hash_bytes(data, 100));
+    std::string copy(reinterpret_cast<char*>(data) + 1, 100);
+    EXPECT_TRUE(android::hash_bytes(data + 1, 100) ==
+                android::hash_bytes(copy.data(), 100));
+    return true;
+}
+
 }  // namespace android
 
 int main(int argc, char **argv)
 {
     FAIL_UNLESS(testInteger);
+    FAIL_UNLESS(testHash);
+    FAIL_UNLESS(testHashBytes);
 }
@@ -64,10 +64,21 @@ bool testSetBase() {
     return true;
 }
 
+bool testSetFillAndWidth() {
+    os s;
+    EXPECT_TRUE(s.fill() == ' ');
+    EXPECT_TRUE(s.width() == 0);
+    s << std::setfill('0') << std::setw(8);
+    EXPECT_TRUE(s.fill() == '0');
+    EXPECT_TRUE(s.width() == 8);
+    return true;
+}
+
 }  // namespace android
 
 int main(int argc, char **argv){
     FAIL_UNLESS(testSetPrecision);
     FAIL_UNLESS(testSetBase);
+    FAIL_UNLESS(testSetFillAndWidth);
     return kPassed;
 }
@@ -180,6 +180,324 @@ bool testPushPop() {
     return true;
 }
 
+bool testNodePool() {
+    ListNodePool pool(sizeof(ListNode<int>));
+    EXPECT_TRUE(pool.chunkCount() == 0);
+
+    // The chunks grow geometrically: few mallocs for many nodes.
+    void *nodes[10000];
+    for (int i = 0; i < 10000; ++i) {
+        nodes[i] = pool.allocate();
+        EXPECT_TRUE(nodes[i] != NULL);
+    }
+    const size_t chunks = pool.chunkCount();
+    EXPECT_TRUE(chunks > 1);
+    EXPECT_TRUE(chunks < 100);
+
+    // Freed nodes are reused, last in first out.
+    pool.deallocate(nodes[10]);
+    pool.deallocate(nodes[20]);
+    EXPECT_TRUE(pool.allocate() == nodes[20]);
+    EXPECT_TRUE(pool.allocate() == nodes[10]);
+    for (int i = 0; i < 10000; ++i) {
+        pool.deallocate(nodes[i]);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        pool.allocate();
+    }
+    EXPECT_TRUE(pool.chunkCount() == chunks);
+
+    pool.release();
+    EXPECT_TRUE(pool.chunkCount() == 0);
+    return true;
+}
+
+bool testNodeAllocations() {
+    list<int> l;
+    const size_t empty = heapAllocatedBytes();
+
+    for (int i = 0; i < 1000; ++i) {
+        l.push_back(i);
+    }
+    const size_t full = heapAllocatedBytes();
+    EXPECT_TRUE(full > empty);
+
+    // Erased nodes are recycled: no new memory.
+    for (int j = 0; j < 10; ++j) {
+        for (int i = 0; i < 500; ++i) {
+            l.pop_front();
+        }
+        for (int i = 0; i < 500; ++i) {
+            l.push_back(i);
+        }
+    }
+    EXPECT_TRUE(heapAllocatedBytes() == full);
+    EXPECT_TRUE(l.size() == 1000);
+
+    // clear() returns the chunks.
+    l.clear();
+    EXPECT_TRUE(heapAllocatedBytes() < full);
+    l.push_back(1);
+    EXPECT_TRUE(l.front() == 1);
+
+    // Non POD elements are destroyed.
+    {
+        list<string> s;
+        for (int i = 0; i < 100; ++i) {
+            s.push_back("a string too long for the inline buffer");
+        }
+        const size_t strings = heapAllocatedBytes();
+        s.pop_back();
+        s.clear();
+        EXPECT_TRUE(heapAllocatedBytes() < strings);
+        s.push_back("again");
+        EXPECT_TRUE(s.front() == "again");
+    }
+    return true;
+}
+
+// @return true if l holds the values in [first, last).
+template<typename _T>
+bool equals(const list<_T>& l, const _T *first, const _T *last) {
+    typename list<_T>::const_iterator i = l.begin();
+    size_t n = 0;
+    for (; i != l.end() && first != last; ++i, ++first, ++n) {
+        if (!(*i == *first)) {
+            return false;
+        }
+    }
+    return i == l.end() && first == last && n == l.size();
+}
+
+// Walk the list backward to check the prev links.
+template<typename _T>
+bool backwardSize(const list<_T>& l, size_t size) {
+    typename list<_T>::const_iterator i = l.end();
+    size_t n = 0;
+    while (i != l.begin()) {
+        --i;
+        ++n;
+    }
+    return n == size;
+}
+
+struct IsOdd {
+    bool operator()(int value) const { return value % 2 != 0; }
+};
+
+bool testSplice() {
+    const int kA[] = {1, 2, 3};
+    const int kB[] = {10, 20, 30};
+    list<int> a, b;
+    for (int i = 0; i < 3; ++i) {
+        a.push_back(kA[i]);
+        b.push_back(kB[i]);
+    }
+
+    // Whole list, iterators remain valid.
+    list<int>::iterator twenty = ++b.begin();
+    a.splice(++a.begin(), b);
+    const int kExpected1[] = {1, 10, 20, 30, 2, 3};
+    EXPECT_TRUE(equals(a, kExpected1, kExpected1 + 6));
+    EXPECT_TRUE(b.empty());
+    EXPECT_TRUE(*twenty == 20);
+
+    // One element from another list and within the list.
+    b.splice(b.end(), a, twenty);
+    EXPECT_TRUE(b.size() == 1 && b.front() == 20);
+    EXPECT_TRUE(a.size() == 5);
+    a.splice(a.begin(), a, --a.end());
+    const int kExpected2[] = {3, 1, 10, 30, 2};
+    EXPECT_TRUE(equals(a, kExpected2, kExpected2 + 5));
+
+    // Range.
+    list<int>::iterator first = a.begin();
+    list<int>::iterator last = first;
+    ++last;
+    ++last;
+    b.splice(b.begin(), a, first, last);
+    const int kExpected3[] = {3, 1, 20};
+    EXPECT_TRUE(equals(b, kExpected3, kExpected3 + 3));
+    EXPECT_TRUE(a.size() == 3);
+    EXPECT_TRUE(backwardSize(a, 3) && backwardSize(b, 3));
+
+    // b holds nodes allocated by a's pool: clearing a must not free
+    // them.
+    a.clear();
+    b.push_back(4);
+    EXPECT_TRUE(b.front() == 3 && b.back() == 4);
+    return true;
+}
+
+// The chunks of a released pool are freed with the last of their
+// nodes living in other lists.
+bool testSpliceMemory() {
+    list<int> keep;
+    keep.push_back(0);
+    const size_t heap = heapAllocatedBytes();
+    for (int i = 0; i < 1000; ++i) {
+        list<int> tmp;
+        for (int j = 0; j < 100; ++j) {
+            tmp.push_back(j);
+        }
+        keep.splice(keep.end(), tmp);
+        keep.erase(++keep.begin(), keep.end());
+    }
+    EXPECT_TRUE(heapAllocatedBytes() == heap);
+
+    {
+        list<string> a, b;
+        for (int i = 0; i < 100; ++i) {
+            a.push_back("a string too long for the inline buffer");
+        }
+        list<string>::iterator first = a.begin();
+        for (int i = 0; i < 10; ++i) {
+            ++first;
+        }
+        b.splice(b.end(), a, first, a.end());
+        a.clear();
+        a.push_back("again");
+        EXPECT_TRUE(b.size() == 90);
+        EXPECT_TRUE(b.front() == "a string too long for the inline buffer");
+        a.splice(a.end(), b, b.begin());
+        b.clear();
+        EXPECT_TRUE(a.size() == 2 && a.front() == "again");
+    }
+    EXPECT_TRUE(heapAllocatedBytes() == heap);
+    return true;
+}
+
+bool testRemoveUnique() {
+    list<int> l;
+    const int kValues[] = {1, 1, 2, 3, 3, 3, 1, 4, 4};
+    for (size_t i = 0; i < ARRAYSIZE(kValues); ++i) {
+        l.push_back(kValues[i]);
+    }
+    l.unique();
+    const int kUnique[] = {1, 2, 3, 1, 4};
+    EXPECT_TRUE(equals(l, kUnique, kUnique + 5));
+
+    l.remove(1);
+    const int kRemoved[] = {2, 3, 4};
+    EXPECT_TRUE(equals(l, kRemoved, kRemoved + 3));
+
+    l.remove_if(IsOdd());
+    EXPECT_TRUE(l.size() == 2 && l.front() == 2 && l.back() == 4);
+    EXPECT_TRUE(backwardSize(l, 2));
+
+    // The value is one of the elements.
+    const int kAliased[] = {5, 6, 5, 5};
+    l.clear();
+    for (size_t i = 0; i < ARRAYSIZE(kAliased); ++i) {
+        l.push_back(kAliased[i]);
+    }
+    l.remove(*++l.begin());
+    l.remove(l.front());
+    EXPECT_TRUE(l.empty());
+
+    list<string> s;
+    s.push_back("a string too long for the inline buffer");
+    s.push_back("b");
+    s.push_back("a string too long for the inline buffer");
+    s.remove(s.front());
+    EXPECT_TRUE(s.size() == 1 && s.front() == "b");
+    return true;
+}
+
+bool testReverse() {
+    list<int> l;
+    l.reverse();
+    EXPECT_TRUE(l.empty());
+    for (int i = 0; i < 5; ++i) {
+        l.push_back(i);
+    }
+    l.reverse();
+    const int kExpected[] = {4, 3, 2, 1, 0};
+    EXPECT_TRUE(equals(l, kExpected, kExpected + 5));
+    EXPECT_TRUE(backwardSize(l, 5));
+    return true;
+}
+
+// Sorted by key only to check the sort is stable.
+struct Pair {
+    Pair(int key, int order): mKey(key), mOrder(order) { }
+    bool operator<(const Pair& other) const { return mKey < other.mKey; }
+    int mKey;
+    int mOrder;
+};
+
+struct KeyGreater {
+    bool operator()(const Pair& a, const Pair& b) const { return b.mKey < a.mKey; }
+};
+
+bool testSortStress() {
+    const int kSize = 1000000;
+    list<Pair> l;
+    unsigned int seed = 1;
+    for (int i = 0; i < kSize; ++i) {
+        seed = seed * 1103515245 + 12345;
+        l.push_back(Pair((seed >> 8) % 1000, i));
+    }
+    const Pair *first = &l.front();
+
+    const size_t heap = heapAllocatedBytes();
+    l.sort();
+    EXPECT_TRUE(heapAllocatedBytes() == heap);  // no allocation
+    EXPECT_TRUE(l.size() == static_cast<size_t>(kSize));
+    EXPECT_TRUE(backwardSize(l, kSize));
+
+    list<Pair>::iterator prev = l.begin();
+    bool found_first = &*prev == first;
+    for (list<Pair>::iterator i = ++l.begin(); i != l.end(); ++i, ++prev) {
+        EXPECT_TRUE(prev->mKey < i->mKey ||
+                    (prev->mKey == i->mKey && prev->mOrder < i->mOrder));
+        found_first |= &*i == first;
+    }
+    EXPECT_TRUE(found_first);  // relinked, not copied
+
+    l.sort(KeyGreater());
+    EXPECT_TRUE(l.front().mKey == 999 && l.back().mKey == 0);
+
+    l.reverse();
+    EXPECT_TRUE(l.front().mKey == 0 && l.back().mKey == 999);
+    return true;
+}
+
+bool testMergeSpliceStress() {
+    const int kSize = 500000;
+    list<int> evens, odds;
+    for (int i = 0; i < kSize; ++i) {
+        evens.push_back(2 * i);
+        odds.push_back(2 * i + 1);
+    }
+    const size_t heap = heapAllocatedBytes();
+    evens.merge(odds);
+    EXPECT_TRUE(odds.empty());
+    EXPECT_TRUE(evens.size() == 2 * static_cast<size_t>(kSize));
+    int expected = 0;
+    for (list<int>::iterator i = evens.begin(); i != evens.end(); ++i, ++expected) {
+        EXPECT_TRUE(*i == expected);
+    }
+    EXPECT_TRUE(backwardSize(evens, 2 * kSize));
+
+    // Move the elements back and forth one at a time.
+    for (int i = 0; i < kSize; ++i) {
+        odds.splice(odds.end(), evens, evens.begin());
+    }
+    EXPECT_TRUE(odds.size() == static_cast<size_t>(kSize));
+    EXPECT_TRUE(evens.size() == static_cast<size_t>(kSize));
+    EXPECT_TRUE(odds.back() == kSize - 1 && evens.front() == kSize);
+    evens.splice(evens.begin(), odds);
+    EXPECT_TRUE(evens.size() == 2 * static_cast<size_t>(kSize));
+    EXPECT_TRUE(evens.front() == 0);
+    EXPECT_TRUE(heapAllocatedBytes() == heap);  // no allocation
+
+    evens.remove_if(IsOdd());
+    evens.unique();
+    EXPECT_TRUE(evens.size() == static_cast<size_t>(kSize));
+    return true;
+}
+
 }  // namespace android
 
 int main(int argc, char **argv)
@@ -191,5 +509,13 @@ int main(int argc, char **argv)
     FAIL_UNLESS(testErase);
     FAIL_UNLESS(testEraseRange);
     FAIL_UNLESS(testPushPop);
+    FAIL_UNLESS(testNodePool);
+    FAIL_UNLESS(testNodeAllocations);
+    FAIL_UNLESS(testSplice);
+    FAIL_UNLESS(testSpliceMemory);
+    FAIL_UNLESS(testRemoveUnique);
+    FAIL_UNLESS(testReverse);
+    FAIL_UNLESS(testSortStress);
+    FAIL_UNLESS(testMergeSpliceStress);
     return kPassed;
 }
@@ -0,0 +1,188 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "../include/map"
+#ifndef ANDROID_ASTL_MAP__
+#error "Wrong header included!!"
+#endif
+#include <string>
+#include "common.h"
+
+namespace android {
+using std::map;
+using std::pair;
+using std::string;
+
+bool testConstructor()
+{
+    map<int, int> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_TRUE(m.size() == 0);
+    EXPECT_TRUE(m.begin() == m.end());
+    EXPECT_TRUE(m.find(10) == m.end());
+    return true;
+}
+
+bool testInsert()
+{
+    map<int, string> m;
+    pair<map<int, string>::iterator, bool> res;
+
+    res = m.insert(std::make_pair(10, string("ten")));
+    EXPECT_TRUE(res.second);
+    EXPECT_TRUE(res.first == m.begin());
+    EXPECT_TRUE(res.first->first == 10);
+    EXPECT_TRUE(res.first->second == "ten");
+
+    // Same key: no insertion, the iterator points to the original.
+    map<int, string>::iterator original = res.first;
+    res = m.insert(std::make_pair(10, string("dix")));
+    EXPECT_TRUE(!res.second);
+    EXPECT_TRUE(res.first == original);
+    EXPECT_TRUE(res.first->second == "ten");
+
+    m.insert(std::make_pair(5, string("five")));
+    m.insert(std::make_pair(20, string("twenty")));
+    EXPECT_TRUE(m.size() == 3);
+
+    // Ordered.
+    map<int, string>::const_iterator i = m.begin();
+    EXPECT_TRUE(i->first == 5);
+    ++i;
+    EXPECT_TRUE(i->first == 10);
+    ++i;
+    EXPECT_TRUE(i->first == 20);
+    ++i;
+    EXPECT_TRUE(i == m.end());
+    return true;
+}
+
+bool testSubscript()
+{
+    map<string, int> m;
+
+    m["one"] = 1;
+    m["two"] = 2;
+    EXPECT_TRUE(m.size() == 2);
+    EXPECT_TRUE(m["one"] == 1);
+    EXPECT_TRUE(m["two"] == 2);
+
+    // Missing key: inserts a default value.
+    EXPECT_TRUE(m["three"] == 0);
+    EXPECT_TRUE(m.size() == 3);
+
+    ++m["one"];
+    EXPECT_TRUE(m.find("one")->second == 2);
+    return true;
+}
+
+bool testFindErase()
+{
+    map<int, int> m;
+    for (int i = 0; i < 1000; ++i) {
+        m[i] = i * i;
+    }
+    EXPECT_TRUE(m.size() == 1000);
+    EXPECT_TRUE(m.find(30)->second == 900);
+    EXPECT_TRUE(m.count(999) == 1);
+    EXPECT_TRUE(m.count(1000) == 0);
+
+    EXPECT_TRUE(m.erase(30) == 1);
+    EXPECT_TRUE(m.erase(30) == 0);
+    EXPECT_TRUE(m.find(30) == m.end());
+
+    m.erase(m.begin());
+    EXPECT_TRUE(m.begin()->first == 1);
+
+    m.erase(m.lower_bound(100), m.upper_bound(199));
+    EXPECT_TRUE(m.lower_bound(100)->first == 200);
+    EXPECT_TRUE(m.size() == 1000 - 2 - 100);
+
+    const map<int, int>& cm = m;
+    EXPECT_TRUE(cm.find(500)->second == 250000);
+    EXPECT_TRUE(cm.lower_bound(150)->first == 200);
+    EXPECT_TRUE(cm.upper_bound(200)->first == 201);
+
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    return true;
+}
+
+bool testCopyAndSwap()
+{
+    map<int, string> m1;
+    m1[1] = "one";
+    m1[2] = "two";
+
+    map<int, string> m2(m1);
+    m1[1] = "uno";
+    EXPECT_TRUE(m2[1] == "one");
+    EXPECT_TRUE(m2.size() == 2);
+
+    map<int, string> m3;
+    m3[3] = "three";
+    m3.swap(m1);
+    EXPECT_TRUE(m3[1] == "uno");
+    EXPECT_TRUE(m1.size() == 1);
+    EXPECT_TRUE(m1.begin()->second == "three");
+
+    m1 = m2;
+    EXPECT_TRUE(m1.size() == 2);
+    EXPECT_TRUE(m1[2] == "two");
+    return true;
+}
+
+bool testComparator()
+{
+    map<int, int, std::greater<int> > m;
+    for (int i = 0; i < 10; ++i) {
+        m[i] = i;
+    }
+    int expected = 9;
+    for (map<int, int, std::greater<int> >::iterator i = m.begin();
+         i != m.end(); ++i, --expected) {
+        EXPECT_TRUE(i->first == expected);
+    }
+    EXPECT_TRUE(expected == -1);
+    EXPECT_TRUE(m.lower_bound(20)->first == 9);
+    return true;
+}
+
+}  // namespace android
+
+int main(int argc, char **argv)
+{
+    FAIL_UNLESS(testConstructor);
+    FAIL_UNLESS(testInsert);
+    FAIL_UNLESS(testSubscript);
+    FAIL_UNLESS(testFindErase);
+    FAIL_UNLESS(testCopyAndSwap);
+    FAIL_UNLESS(testComparator);
+    return kPassed;
+}
@@ -32,6 +32,7 @@
 #endif
 #include "common.h"
 #include <iterator>
+#include <vector>
 
 namespace android {
 
@@ -72,11 +73,57 @@ bool testUnitializedCopyClassRandomIterators() {
     return true;
 }
 
+struct Pair64 {
+    long long first;
+    long long second;
+};
+
+bool testUninitializedFill() {
+    // Bitwise copyable values go through std::fill.
+    const size_t kLen = 100;
+    double *values = static_cast<double*>(malloc(kLen * sizeof(double)));
+    std::uninitialized_fill(values, values + kLen, 2.5);
+    for (size_t i = 0; i < kLen; ++i) {
+        EXPECT_TRUE(values[i] == 2.5);
+    }
+    free(values);
+
+    Pair64 *pairs = static_cast<Pair64*>(malloc(kLen * sizeof(Pair64)));
+    const Pair64 value = {-1, 42};
+    std::uninitialized_fill(pairs, pairs + kLen, value);
+    for (size_t i = 0; i < kLen; ++i) {
+        EXPECT_TRUE(pairs[i].first == -1 && pairs[i].second == 42);
+    }
+    free(pairs);
+
+    // Conversion from the value's type.
+    int ints[kLen];
+    std::uninitialized_fill(ints, ints + kLen, 'a');
+    EXPECT_TRUE(ints[0] == 'a' && ints[kLen - 1] == 'a');
+
+    // Others are copy constructed.
+    CtorDtorCounter *counters = static_cast<CtorDtorCounter*>(
+        malloc(kLen * sizeof(CtorDtorCounter)));
+    const CtorDtorCounter counter;
+    CtorDtorCounter::reset();
+    std::uninitialized_fill(counters, counters + kLen, counter);
+    EXPECT_TRUE(kLen == CtorDtorCounter::mCopyCtorCount);
+    EXPECT_TRUE(0 == CtorDtorCounter::mCtorCount);
+    free(counters);
+
+    // Iterators.
+    std::vector<int> vec(kLen, 0);
+    std::uninitialized_fill(vec.begin() + 1, vec.end(), 5);
+    EXPECT_TRUE(vec[0] == 0 && vec[1] == 5 && vec[kLen - 1] == 5);
+    return true;
+}
+
 }  // namespace android
 
 int main(int argc, char **argv)
 {
     FAIL_UNLESS(testUnitializedCopyPODRandomIterators);
     FAIL_UNLESS(testUnitializedCopyClassRandomIterators);
+    FAIL_UNLESS(testUninitializedFill);
     return kPassed;
 }
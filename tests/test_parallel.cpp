@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "../include/parallel.h"
+#ifndef ANDROID_ASTL_PARALLEL_H__
+#error "Wrong header included!!"
+#endif
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "common.h"
+
+namespace android {
+
+const size_t kThreads[] = {1, 2, 4, 8};
+const size_t kSizes[] = {0, 1, 7, 100, 1000, 12345};
+
+unsigned int nextRandom(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return state >> 8;
+}
+
+struct Square {
+    int operator()(int x) const { return x * x; }
+};
+
+struct Add {
+    int operator()(int x, int y) const { return x + y; }
+};
+
+// Counts the calls using an atomic increment.
+struct Counter {
+    Counter(int *count): mCount(count) { }
+    void operator()(int& x) {
+        x += 1;
+        __sync_fetch_and_add(mCount, 1);
+    }
+    int *mCount;
+};
+
+// Non commutative reduction: the chunks must be combined in order.
+struct Concat {
+    std::string operator()(const std::string& lhs,
+                           const std::string& rhs) const {
+        return lhs + rhs;
+    }
+};
+
+bool testFillCopy()
+{
+    for (size_t t = 0; t < ARRAYSIZE(kThreads); ++t) {
+        par::set_thread_count(kThreads[t]);
+        for (size_t s = 0; s < ARRAYSIZE(kSizes); ++s) {
+            const size_t n = kSizes[s];
+            std::vector<int> a(n, 0);
+            par::fill(a.begin(), a.end(), 42);
+            EXPECT_TRUE(std::count(a.begin(), a.end(), 42) == int(n));
+
+            std::vector<int> b(n, 0);
+            for (size_t i = 0; i < n; ++i) {
+                a[i] = i;
+            }
+            EXPECT_TRUE(par::copy(a.begin(), a.end(), b.begin()) == b.end());
+            EXPECT_TRUE(std::equal(a.begin(), a.end(), b.begin()));
+        }
+    }
+    return true;
+}
+
+bool testTransformForEach()
+{
+    for (size_t t = 0; t < ARRAYSIZE(kThreads); ++t) {
+        par::set_thread_count(kThreads[t]);
+        for (size_t s = 0; s < ARRAYSIZE(kSizes); ++s) {
+            const size_t n = kSizes[s];
+            std::vector<int> a, b(n, 0), c(n, 0);
+            for (size_t i = 0; i < n; ++i) {
+                a.push_back(i % 1000);
+            }
+            EXPECT_TRUE(par::transform(a.begin(), a.end(), b.begin(),
+                                       Square()) == b.end());
+            EXPECT_TRUE(par::transform(a.begin(), a.end(), b.begin(),
+                                       c.begin(), Add()) == c.end());
+            for (size_t i = 0; i < n; ++i) {
+                EXPECT_TRUE(b[i] == a[i] * a[i]);
+                EXPECT_TRUE(c[i] == a[i] + b[i]);
+            }
+
+            int count = 0;
+            par::for_each(a.begin(), a.end(), Counter(&count));
+            EXPECT_TRUE(count == int(n));
+            for (size_t i = 0; i < n; ++i) {
+                EXPECT_TRUE(a[i] == int(i % 1000) + 1);
+            }
+        }
+    }
+    return true;
+}
+
+bool testReduce()
+{
+    for (size_t t = 0; t < ARRAYSIZE(kThreads); ++t) {
+        par::set_thread_count(kThreads[t]);
+        for (size_t s = 0; s < ARRAYSIZE(kSizes); ++s) {
+            const size_t n = kSizes[s];
+            std::vector<long long> a;
+            long long expected = 5;
+            for (size_t i = 0; i < n; ++i) {
+                a.push_back(i * 3);
+                expected += i * 3;
+            }
+            EXPECT_TRUE(par::reduce(a.begin(), a.end(), 5LL) == expected);
+        }
+
+        std::vector<std::string> words;
+        std::string expected("<");
+        for (int i = 0; i < 1000; ++i) {
+            const char c = 'a' + i % 26;
+            words.push_back(std::string(&c, 1));
+            expected += words.back();
+        }
+        EXPECT_TRUE(par::reduce(words.begin(), words.end(), std::string("<"),
+                                Concat()) == expected);
+    }
+    return true;
+}
+
+template<typename _T>
+bool checkSort(size_t n, unsigned int mask) {
+    std::vector<_T> data;
+    unsigned int state = n;
+    for (size_t i = 0; i < n; ++i) {
+        data.push_back(nextRandom(state) & mask);
+    }
+    std::vector<_T> expected(data.begin(), data.end());
+    std::sort(expected.begin(), expected.end());
+    par::sort(data.begin(), data.end());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), expected.begin()));
+
+    // Descending, on a raw array.
+    par::sort(&data[0], &data[0] + n, std::greater<_T>());
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_TRUE(data[i] == expected[n - 1 - i]);
+    }
+    return true;
+}
+
+bool testSort()
+{
+    const size_t sizes[] = {2, 100, 1000, 12345, 100001};
+    for (size_t t = 0; t < ARRAYSIZE(kThreads); ++t) {
+        par::set_thread_count(kThreads[t]);
+        for (size_t s = 0; s < ARRAYSIZE(sizes); ++s) {
+            EXPECT_TRUE(checkSort<int>(sizes[s], ~0u));
+            EXPECT_TRUE(checkSort<int>(sizes[s], 0xf));  // Many duplicates.
+            EXPECT_TRUE(checkSort<double>(sizes[s], 0xffff));
+        }
+
+        // Non POD values: the merge buffer holds constructed strings.
+        std::vector<std::string> strings;
+        unsigned int state = 1;
+        for (int i = 0; i < 5000; ++i) {
+            const char c = 'a' + nextRandom(state) % 26;
+            strings.push_back(std::string(&c, 1) + "x");
+        }
+        par::sort(strings.begin(), strings.end());
+        for (size_t i = 1; i < strings.size(); ++i) {
+            EXPECT_TRUE(!(strings[i] < strings[i - 1]));
+        }
+    }
+    return true;
+}
+
+// Parallel calls made from a chunk run sequentially.
+struct Nested {
+    void operator()(std::vector<int>& v) {
+        par::fill(v.begin(), v.end(), 7);
+    }
+};
+
+bool testNested()
+{
+    par::set_thread_count(4);
+    static std::vector<int> rows[50];
+    for (size_t i = 0; i < ARRAYSIZE(rows); ++i) {
+        rows[i].resize(300, 0);
+    }
+    par::for_each(rows, rows + ARRAYSIZE(rows), Nested());
+    for (size_t i = 0; i < ARRAYSIZE(rows); ++i) {
+        EXPECT_TRUE(std::count(rows[i].begin(), rows[i].end(), 7) == 300);
+    }
+    return true;
+}
+
+bool testSettings()
+{
+    par::set_grain_size(0);
+    EXPECT_TRUE(par::grain_size() == par::kDefaultGrainSize);
+    par::set_thread_count(0);
+    EXPECT_TRUE(par::thread_count() >= 1);
+    return true;
+}
+
+}  // namespace android
+
+int main(int argc, char **argv)
+{
+    // Small chunks to exercise the splitting.
+    android::par::set_grain_size(16);
+    FAIL_UNLESS(testFillCopy);
+    FAIL_UNLESS(testTransformForEach);
+    FAIL_UNLESS(testReduce);
+    FAIL_UNLESS(testSort);
+    FAIL_UNLESS(testNested);
+    FAIL_UNLESS(testSettings);
+    return kPassed;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+
+#include "../include/queue"
+#ifndef ANDROID_ASTL_QUEUE__
+#error "Wrong header included!!"
+#endif
+#include <dary_heap.h>
+#include <functional>
+#include <string>
+#include "common.h"
+
+namespace android {
+using std::priority_queue;
+
+bool testEmpty()
+{
+    priority_queue<int> queue;
+    EXPECT_TRUE(queue.empty());
+    EXPECT_TRUE(queue.size() == 0);
+    queue.pop();  // No-op.
+    EXPECT_TRUE(queue.empty());
+
+    dary_priority_queue<int> dary;
+    EXPECT_TRUE(dary.empty());
+    dary.pop();
+    EXPECT_TRUE(dary.size() == 0);
+    return true;
+}
+
+// Push pseudo random values in _Queue then pop them all: they must
+// come out in non increasing order.
+template<typename _Queue>
+bool checkPushPop(_Queue& queue, int n) {
+    unsigned int seed = n;
+    for (int i = 0; i < n; ++i) {
+        seed = seed * 1103515245 + 12345;
+        queue.push((seed >> 16) % 1000);
+        EXPECT_TRUE(queue.size() == static_cast<size_t>(i + 1));
+    }
+    int previous = queue.top();
+    for (int i = 0; i < n; ++i) {
+        EXPECT_TRUE(queue.top() <= previous);
+        previous = queue.top();
+        queue.pop();
+    }
+    EXPECT_TRUE(queue.empty());
+    return true;
+}
+
+bool testPushPop()
+{
+    const int sizes[] = {1, 2, 3, 4, 5, 17, 100, 10000};
+    for (size_t i = 0; i < ARRAYSIZE(sizes); ++i) {
+        priority_queue<int> queue;
+        EXPECT_TRUE(checkPushPop(queue, sizes[i]));
+        dary_priority_queue<int> dary;
+        EXPECT_TRUE(checkPushPop(dary, sizes[i]));
+        dary_priority_queue<int, 2> binary;
+        EXPECT_TRUE(checkPushPop(binary, sizes[i]));
+        dary_priority_queue<int, 8> octary;
+        EXPECT_TRUE(checkPushPop(octary, sizes[i]));
+    }
+    return true;
+}
+
+bool testCompare()
+{
+    // Min queue.
+    priority_queue<int, std::vector<int>, std::greater<int> > queue;
+    queue.push(3);
+    queue.push(1);
+    queue.push(2);
+    EXPECT_TRUE(queue.top() == 1);
+    queue.pop();
+    EXPECT_TRUE(queue.top() == 2);
+
+    dary_priority_queue<int, 4, std::greater<int> > dary;
+    dary.push(3);
+    dary.push(1);
+    dary.push(2);
+    EXPECT_TRUE(dary.top() == 1);
+    dary.pop();
+    EXPECT_TRUE(dary.top() == 2);
+    return true;
+}
+
+bool testRange()
+{
+    const int ints[] = {4, 9, 1, 7};
+    priority_queue<int> queue(ints, ints + 4);
+    EXPECT_TRUE(queue.size() == 4);
+    EXPECT_TRUE(queue.top() == 9);
+    queue.pop();
+    EXPECT_TRUE(queue.top() == 7);
+
+    priority_queue<int> other;
+    other.push(100);
+    queue.swap(other);
+    EXPECT_TRUE(queue.top() == 100);
+    EXPECT_TRUE(other.size() == 3);
+    return true;
+}
+
+bool testNonPod()
+{
+    priority_queue<std::string> queue;
+    queue.push("b");
+    queue.push("c");
+    queue.push("a");
+    EXPECT_TRUE(queue.top() == "c");
+    queue.pop();
+    EXPECT_TRUE(queue.top() == "b");
+
+    dary_priority_queue<std::string> dary;
+    dary.push("b");
+    dary.push("c");
+    dary.push("a");
+    EXPECT_TRUE(dary.top() == "c");
+    dary.pop();
+    EXPECT_TRUE(dary.top() == "b");
+    return true;
+}
+
+bool testDaryHeap()
+{
+    int data[50];
+    for (int i = 0; i < 50; ++i) {
+        data[i] = (i * 37) % 50;
+    }
+    make_dary_heap<4>(data, data + 50, std::less<int>());
+    EXPECT_TRUE(is_dary_heap<4>(data, data + 50, std::less<int>()));
+    EXPECT_TRUE(data[0] == 49);
+    for (int len = 50; len > 1; --len) {
+        pop_dary_heap<4>(data, data + len, std::less<int>());
+        EXPECT_TRUE(data[len - 1] == len - 1);
+        EXPECT_TRUE(is_dary_heap<4>(data, data + len - 1, std::less<int>()));
+    }
+    for (int len = 1; len <= 50; ++len) {
+        push_dary_heap<3>(data, data + len, std::less<int>());
+        EXPECT_TRUE(is_dary_heap<3>(data, data + len, std::less<int>()));
+    }
+    return true;
+}
+
+}  // namespace android
+
+int main(int argc, char **argv)
+{
+    FAIL_UNLESS(testEmpty);
+    FAIL_UNLESS(testPushPop);
+    FAIL_UNLESS(testCompare);
+    FAIL_UNLESS(testRange);
+    FAIL_UNLESS(testNonPod);
+    FAIL_UNLESS(testDaryHeap);
+    return kPassed;
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+
+#include "../include/radix_sort.h"
+#ifndef ANDROID_ASTL_RADIX_SORT_H__
+#error "Wrong header included!!"
+#endif
+#include <cstring>
+#include <string>
+#include <vector>
+#include "common.h"
+
+namespace android {
+
+// Pseudo random values covering the full range of the type.
+unsigned long long nextRandom(unsigned long long& state) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return state ^ (state >> 29);
+}
+
+// Radix sort n random values of type _T, optionally masked to a
+// few low bits, and compare with std::sort.
+template<typename _T>
+bool checkRadixSort(size_t n, unsigned long long mask) {
+    std::vector<_T> data;
+    unsigned long long state = n;
+    for (size_t i = 0; i < n; ++i) {
+        data.push_back(static_cast<_T>(nextRandom(state) & mask));
+    }
+    std::vector<_T> expected(data.begin(), data.end());
+    std::sort(expected.begin(), expected.end());
+
+    radix_sort(data);
+    EXPECT_TRUE(data.size() == n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_TRUE(data[i] == expected[i]);
+    }
+    return true;
+}
+
+template<typename _T>
+bool checkAllSizes() {
+    const size_t sizes[] = {0, 1, 2, 100, 255, 256, 257, 1000, 4096, 100000};
+    for (size_t i = 0; i < ARRAYSIZE(sizes); ++i) {
+        EXPECT_TRUE(checkRadixSort<_T>(sizes[i], ~0ULL));
+        EXPECT_TRUE(checkRadixSort<_T>(sizes[i], 0xffULL));
+        EXPECT_TRUE(checkRadixSort<_T>(sizes[i], 0xff00ULL));
+    }
+    return true;
+}
+
+bool testUnsigned()
+{
+    EXPECT_TRUE(checkAllSizes<unsigned char>());
+    EXPECT_TRUE(checkAllSizes<unsigned short>());
+    EXPECT_TRUE(checkAllSizes<unsigned int>());
+    EXPECT_TRUE(checkAllSizes<unsigned long>());
+    EXPECT_TRUE(checkAllSizes<unsigned long long>());
+    EXPECT_TRUE(checkAllSizes<bool>());
+    return true;
+}
+
+bool testSigned()
+{
+    EXPECT_TRUE(checkAllSizes<char>());
+    EXPECT_TRUE(checkAllSizes<signed char>());
+    EXPECT_TRUE(checkAllSizes<short>());
+    EXPECT_TRUE(checkAllSizes<int>());
+    EXPECT_TRUE(checkAllSizes<long>());
+    EXPECT_TRUE(checkAllSizes<long long>());
+
+    // Extreme values.
+    const int n = 4000;
+    static int array[n];
+    for (int i = 0; i < n; ++i) {
+        array[i] = i % 4 == 0 ? -2147483647 - 1 :
+                i % 4 == 1 ? 2147483647 : (i % 4 == 2 ? -1 : 0);
+    }
+    radix_sort(array, array + n);
+    EXPECT_TRUE(array[0] == -2147483647 - 1);
+    EXPECT_TRUE(array[n / 4 - 1] == -2147483647 - 1);
+    EXPECT_TRUE(array[n / 4] == -1);
+    EXPECT_TRUE(array[n / 2] == 0);
+    EXPECT_TRUE(array[n * 3 / 4] == 2147483647);
+    EXPECT_TRUE(array[n - 1] == 2147483647);
+    return true;
+}
+
+bool testAllEqual()
+{
+    // Every pass is skipped, the data must be left untouched.
+    const int n = 4000;
+    static long long array[n];
+    for (int i = 0; i < n; ++i) {
+        array[i] = -12345;
+    }
+    radix_sort(array, array + n);
+    for (int i = 0; i < n; ++i) {
+        EXPECT_TRUE(array[i] == -12345);
+    }
+
+    // Odd number of passes: the result is copied back.
+    static unsigned int values[n];
+    for (int i = 0; i < n; ++i) {
+        values[i] = 0x11220000 | ((n - i) & 0xff);
+    }
+    radix_sort(values, values + n);
+    for (int i = 1; i < n; ++i) {
+        EXPECT_TRUE(values[i - 1] <= values[i]);
+    }
+    EXPECT_TRUE(values[0] == 0x11220000);
+    return true;
+}
+
+bool testOddLengths()
+{
+    // The histograms follow the buffer in the same allocation and
+    // must stay aligned whatever the size of the keys.
+    const size_t sizes[] = {513, 1001, 4097, 65537};
+    for (size_t i = 0; i < ARRAYSIZE(sizes); ++i) {
+        EXPECT_TRUE(checkRadixSort<char>(sizes[i], ~0ULL));
+        EXPECT_TRUE(checkRadixSort<unsigned char>(sizes[i], ~0ULL));
+        EXPECT_TRUE(checkRadixSort<short>(sizes[i], ~0ULL));
+        EXPECT_TRUE(checkRadixSort<unsigned short>(sizes[i], ~0ULL));
+    }
+    return true;
+}
+
+bool testNonIntegral()
+{
+    // Falls back to std::sort.
+    std::vector<std::string> data;
+    data.push_back("c");
+    data.push_back("a");
+    data.push_back("b");
+    radix_sort(data);
+    EXPECT_TRUE(data[0] == "a");
+    EXPECT_TRUE(data[1] == "b");
+    EXPECT_TRUE(data[2] == "c");
+
+    double array[] = {3.0, -1.0, 2.0};
+    radix_sort(array, array + 3);
+    EXPECT_TRUE(array[0] == -1.0);
+    EXPECT_TRUE(array[2] == 3.0);
+    return true;
+}
+
+}  // namespace android
+
+int main(int argc, char **argv)
+{
+    FAIL_UNLESS(testUnsigned);
+    FAIL_UNLESS(testSigned);
+    FAIL_UNLESS(testAllEqual);
+    FAIL_UNLESS(testOddLengths);
+    FAIL_UNLESS(testNonIntegral);
+    return kPassed;
+}
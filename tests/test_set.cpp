@@ -128,6 +128,186 @@ bool testInsertString()
     return true;
 }
 
+bool testOrderedIteration()
+{
+    set<int> s;
+    const int values[] = {5, 3, 9, 1, 7, 3, 2, 8, 6, 4, 0, 9};
+    for (size_t i = 0; i < ARRAYSIZE(values); ++i) {
+        s.insert(values[i]);
+    }
+    EXPECT_TRUE(s.size() == 10);
+
+    int expected = 0;
+    for (set<int>::iterator i = s.begin(); i != s.end(); ++i) {
+        EXPECT_TRUE(*i == expected);
+        ++expected;
+    }
+    EXPECT_TRUE(expected == 10);
+
+    // Backward.
+    set<int>::iterator i = s.end();
+    do {
+        --i;
+        --expected;
+        EXPECT_TRUE(*i == expected);
+    } while (i != s.begin());
+
+    // Range constructor, copy.
+    set<int> copy(values, values + ARRAYSIZE(values));
+    EXPECT_TRUE(copy.size() == 10);
+    set<int> copy2(copy);
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+    EXPECT_TRUE(copy2.size() == 10);
+    EXPECT_TRUE(*copy2.begin() == 0);
+    return true;
+}
+
+bool testFindErase()
+{
+    set<int> s;
+    for (int i = 0; i < 100; i += 2) {
+        s.insert(i);
+    }
+    EXPECT_TRUE(s.find(42) != s.end());
+    EXPECT_TRUE(*s.find(42) == 42);
+    EXPECT_TRUE(s.find(43) == s.end());
+
+    set<int>::iterator it10 = s.find(10);
+    EXPECT_TRUE(s.erase(42) == 1);
+    EXPECT_TRUE(s.erase(42) == 0);
+    EXPECT_TRUE(s.erase(43) == 0);
+    EXPECT_TRUE(s.count(42) == 0);
+    EXPECT_TRUE(s.size() == 49);
+    // Other iterators are still valid.
+    EXPECT_TRUE(*it10 == 10);
+
+    s.erase(s.begin());
+    EXPECT_TRUE(*s.begin() == 2);
+
+    // Erase [20, 30)
+    s.erase(s.find(20), s.find(30));
+    EXPECT_TRUE(s.size() == 43);
+    EXPECT_TRUE(s.count(28) == 0);
+    EXPECT_TRUE(s.count(30) == 1);
+
+    s.erase(s.begin(), s.end());
+    EXPECT_TRUE(s.empty());
+    EXPECT_TRUE(s.begin() == s.end());
+    return true;
+}
+
+bool testBounds()
+{
+    set<int> s;
+    for (int i = 10; i <= 50; i += 10) {
+        s.insert(i);
+    }
+    EXPECT_TRUE(*s.lower_bound(20) == 20);
+    EXPECT_TRUE(*s.upper_bound(20) == 30);
+    EXPECT_TRUE(*s.lower_bound(21) == 30);
+    EXPECT_TRUE(*s.upper_bound(21) == 30);
+    EXPECT_TRUE(*s.lower_bound(0) == 10);
+    EXPECT_TRUE(s.lower_bound(51) == s.end());
+    EXPECT_TRUE(s.upper_bound(50) == s.end());
+    return true;
+}
+
+bool testComparator()
+{
+    set<string, std::greater<string> > s;
+    s.insert("b");
+    s.insert("c");
+    s.insert("a");
+    s.insert("b");
+    EXPECT_TRUE(s.size() == 3);
+
+    set<string, std::greater<string> >::iterator i = s.begin();
+    EXPECT_TRUE(*i == "c");
+    ++i;
+    EXPECT_TRUE(*i == "b");
+    ++i;
+    EXPECT_TRUE(*i == "a");
+    ++i;
+    EXPECT_TRUE(i == s.end());
+    EXPECT_TRUE(*s.lower_bound("c") == "c");
+    EXPECT_TRUE(*s.upper_bound("c") == "b");
+    return true;
+}
+
+bool testSwap()
+{
+    set<int> s1;
+    set<int> s2;
+    s1.insert(1);
+    s1.insert(2);
+
+    s1.swap(s2);
+    EXPECT_TRUE(s1.empty());
+    EXPECT_TRUE(s2.size() == 2);
+    EXPECT_TRUE(*s2.begin() == 1);
+
+    s1.insert(3);
+    s1.swap(s2);
+    EXPECT_TRUE(s1.size() == 2);
+    EXPECT_TRUE(*(--s1.end()) == 2);
+    EXPECT_TRUE(s2.size() == 1);
+    EXPECT_TRUE(*s2.begin() == 3);
+    return true;
+}
+
+// @return The black height of the subtree or -1 if the red-black
+// properties are violated.
+int blackHeight(const TreeNodeBase *node)
+{
+    if (node == NULL) {
+        return 1;
+    }
+    if (node->mColor == TreeNodeBase::kRed &&
+        ((node->mLeft && node->mLeft->mColor == TreeNodeBase::kRed) ||
+         (node->mRight && node->mRight->mColor == TreeNodeBase::kRed))) {
+        return -1;
+    }
+    const int left = blackHeight(node->mLeft);
+    const int right = blackHeight(node->mRight);
+    if (left < 0 || left != right) {
+        return -1;
+    }
+    return left + (node->mColor == TreeNodeBase::kBlack ? 1 : 0);
+}
+
+bool testStress()
+{
+    set<int> s;
+    unsigned int seed = 1;
+    size_t count = 0;
+
+    for (int i = 0; i < 20000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        const int value = (seed >> 8) % 10000;
+        if (value % 3 == 0) {
+            count -= s.erase(value);
+        } else {
+            count += s.insert(value).second ? 1 : 0;
+        }
+    }
+    EXPECT_TRUE(s.size() == count);
+
+    const TreeNodeBase *root = s.end().mNode->mParent;
+    EXPECT_TRUE(root->mColor == TreeNodeBase::kBlack);
+    EXPECT_TRUE(blackHeight(root) > 0);
+
+    // Ordered and no duplicates.
+    size_t n = 0;
+    int last = -1;
+    for (set<int>::iterator i = s.begin(); i != s.end(); ++i, ++n) {
+        EXPECT_TRUE(last < *i);
+        last = *i;
+    }
+    EXPECT_TRUE(n == count);
+    return true;
+}
+
 }  // namespace android
 
 int main(int argc, char **argv)
@@ -135,5 +315,11 @@ int main(int argc, char **argv)
     FAIL_UNLESS(testConstructor);
     FAIL_UNLESS(testInsertPOD);
     FAIL_UNLESS(testInsertString);
+    FAIL_UNLESS(testOrderedIteration);
+    FAIL_UNLESS(testFindErase);
+    FAIL_UNLESS(testBounds);
+    FAIL_UNLESS(testComparator);
+    FAIL_UNLESS(testSwap);
+    FAIL_UNLESS(testStress);
     return kPassed;
 }
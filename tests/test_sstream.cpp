@@ -33,13 +33,20 @@
 #endif
 #include "common.h"
 
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <ios_base.h>
+#include <iomanip>
+#include <limits>
 #include <string>
 
 namespace android {
 using std::stringbuf;
 using std::stringstream;
 using std::string;
+using std::ios_base;
 
 bool testConstructor() {
     {
@@ -99,13 +106,276 @@ bool testPut() {
     return true;
 }
 
+bool testPutOverflow() {
+    stringbuf buf;
+    string expected;
+
+    // Cross the put area boundary several times, mixing single chars,
+    // short and long writes and reads of the string.
+    for (size_t i = 0; i < 3 * stringbuf::kBufferSize + 7; ++i) {
+        const char c = 'a' + i % 26;
+        EXPECT_TRUE(buf.sputc(c) == c);
+        expected.push_back(c);
+        if (i % 100 == 0) {
+            EXPECT_TRUE(buf.sputn("0123456789", 10) == 10);
+            expected.append("0123456789");
+        }
+        if (i % 250 == 0) {
+            EXPECT_TRUE(buf.str() == expected);
+        }
+    }
+    string large(2 * stringbuf::kBufferSize, 'x');
+    EXPECT_TRUE(buf.sputn(large.c_str(), large.size()) == large.size());
+    expected.append(large);
+    EXPECT_TRUE(buf.str() == expected);
+
+    // Pending chars are dropped when the content is replaced.
+    buf.sputc('z');
+    buf.str("new");
+    buf.sputc('!');
+    EXPECT_TRUE(buf.str() == "new!");
+    return true;
+}
+
 bool testStringStream() {
     stringstream ss;
 
     ss << "This is: " << 10 << std::endl;
     EXPECT_TRUE(ss.str() == "This is: 10\n");
+
+    ss.put('a') << 'b';
+    EXPECT_TRUE(ss.str() == "This is: 10\nab");
+    return true;
+}
+// @return The string written by snprintf for fmt and val.
+template<typename _T>
+string sprint(const char *fmt, _T val) {
+    char buf[64];
+    const int len = snprintf(buf, sizeof(buf), fmt, val);
+    return string(buf, len);
+}
+
+template<typename _T>
+bool checkInteger(_T val, const char *dec, const char *oct, const char *hex) {
+    stringstream ss;
+    ss << val;
+    EXPECT_TRUE(ss.str() == sprint(dec, val));
+    ss.str("");
+    ss.setf(ios_base::oct, ios_base::basefield);
+    ss << val;
+    EXPECT_TRUE(ss.str() == sprint(oct, val));
+    ss.str("");
+    ss.setf(ios_base::hex, ios_base::basefield);
+    ss << val;
+    EXPECT_TRUE(ss.str() == sprint(hex, val));
+    return true;
+}
+
+bool testIntegers() {
+    // Powers of 10 and their neighbours cover every digit count.
+    for (long long p = 1; p < std::numeric_limits<long long>::max() / 10;
+         p *= 10) {
+        for (long long val = p - 1; val <= p + 1; ++val) {
+            EXPECT_TRUE(checkInteger(val, "%lld", "%llo", "%llx"));
+            EXPECT_TRUE(checkInteger(-val, "%lld", "%llo", "%llx"));
+            EXPECT_TRUE(checkInteger(static_cast<unsigned long long>(val),
+                                     "%llu", "%llo", "%llx"));
+        }
+    }
+    for (int val = -1000; val <= 1000; ++val) {
+        EXPECT_TRUE(checkInteger(val, "%d", "%o", "%x"));
+        EXPECT_TRUE(checkInteger(static_cast<long>(val) * 9973,
+                                 "%ld", "%lo", "%lx"));
+    }
+    EXPECT_TRUE(checkInteger(std::numeric_limits<int>::min(), "%d", "%o", "%x"));
+    EXPECT_TRUE(checkInteger(std::numeric_limits<int>::max(), "%d", "%o", "%x"));
+    EXPECT_TRUE(checkInteger(std::numeric_limits<unsigned>::max(),
+                             "%u", "%o", "%x"));
+    EXPECT_TRUE(checkInteger(std::numeric_limits<long>::min(),
+                             "%ld", "%lo", "%lx"));
+    EXPECT_TRUE(checkInteger(std::numeric_limits<unsigned long>::max(),
+                             "%lu", "%lo", "%lx"));
+    EXPECT_TRUE(checkInteger(std::numeric_limits<long long>::min(),
+                             "%lld", "%llo", "%llx"));
+    EXPECT_TRUE(checkInteger(std::numeric_limits<unsigned long long>::max(),
+                             "%llu", "%llo", "%llx"));
+    return true;
+}
+
+bool testIntegerFlags() {
+    stringstream ss;
+
+    ss.setf(ios_base::showbase | ios_base::uppercase);
+    ss << 255 << ' ' << std::setbase(16) << 255 << ' ' << 0 << ' '
+       << std::setbase(8) << 8 << ' ' << 0;
+    EXPECT_TRUE(ss.str() == "255 0XFF 0 010 0");
+
+    ss.str("");
+    ss.flags(ios_base::dec | ios_base::showpos);
+    ss << 12 << ' ' << -12 << ' ' << 0 << ' ' << 12u;
+    EXPECT_TRUE(ss.str() == "+12 -12 +0 12");
+
+    // The width applies to the next integer only.
+    ss.str("");
+    ss.flags(ios_base::dec);
+    ss << std::setw(5) << -42 << '|' << -42;
+    EXPECT_TRUE(ss.str() == "  -42|-42");
+
+    ss.str("");
+    ss << std::setfill('*');
+    ss << std::setw(6) << 42 << '|';
+    ss.setf(ios_base::left, ios_base::adjustfield);
+    ss << std::setw(6) << -42 << '|';
+    ss.setf(ios_base::internal, ios_base::adjustfield);
+    ss << std::setw(6) << -42 << '|';
+    ss.setf(ios_base::hex | ios_base::showbase);
+    ss.unsetf(ios_base::dec);
+    ss << std::setw(6) << 42 << '|' << std::setw(2) << 42;
+    EXPECT_TRUE(ss.str() == "****42|-42***|-***42|0x**2a|0x2a");
+    return true;
+}
+
+// Set by --exhaustive: testFloatRoundTrip checks every float.
+bool gExhaustive = false;
+
+// @return The string snprintf writes for val with the conversion, the
+// + and # flags the stream flags select.
+string sprintFloat(double val, ios_base::fmtflags flags, int precision) {
+    char fmt[8];
+    char *f = fmt;
+    *f++ = '%';
+    if (flags & ios_base::showpos) {
+        *f++ = '+';
+    }
+    if (flags & ios_base::showpoint) {
+        *f++ = '#';
+    }
+    *f++ = '.';
+    *f++ = '*';
+    const bool uppercase = (flags & ios_base::uppercase) != 0;
+    const ios_base::fmtflags field = flags & ios_base::floatfield;
+    *f++ = field == ios_base::fixed ? 'f' :
+            field == ios_base::scientific ? (uppercase ? 'E' : 'e') :
+            (uppercase ? 'G' : 'g');
+    *f = '\0';
+    char buf[512];
+    const int len = snprintf(buf, sizeof(buf), fmt, precision, val);
+    return string(buf, len);
+}
+
+template<typename _Float>
+bool checkFloat(_Float val) {
+    const ios_base::fmtflags flags[] = {
+        ios_base::dec,
+        ios_base::fixed,
+        ios_base::scientific,
+        ios_base::fixed | ios_base::showpoint,
+        ios_base::scientific | ios_base::uppercase | ios_base::showpos,
+        ios_base::showpos | ios_base::uppercase,
+    };
+    const int precisions[] = {0, 1, 3, 6, 9, 15, 16, 17, 25, 60};
+    stringstream ss;
+    for (size_t f = 0; f < ARRAYSIZE(flags); ++f) {
+        for (size_t p = 0; p < ARRAYSIZE(precisions); ++p) {
+            ss.str("");
+            ss.flags(flags[f]);
+            ss.precision(precisions[p]);
+            ss << val;
+            if (ss.str() != sprintFloat(val, flags[f], precisions[p])) {
+                fprintf(stderr, "%a flags %x precision %d: %s\n",
+                        static_cast<double>(val), flags[f], precisions[p],
+                        ss.str().c_str());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool testFloats() {
+    const double values[] = {
+        0.0, 1.0, 0.1, 0.5, 2.5, 0.125, 1.0 / 3, 9.5, 99.5, 0.05, 0.0005,
+        9.9999995, 999999.5, 1e-5, 0.00001234, 123456.5, 1e15, 1e16, 1e22,
+        4503599627370496.5, 9007199254740993.0, 12345678901234567890.0,
+        1e300, 5e-324, 2.2250738585072014e-308, 1.7976931348623157e308,
+    };
+    for (size_t i = 0; i < ARRAYSIZE(values); ++i) {
+        EXPECT_TRUE(checkFloat(values[i]));
+        EXPECT_TRUE(checkFloat(-values[i]));
+        EXPECT_TRUE(checkFloat(static_cast<float>(values[i])));
+    }
+    // Random bit patterns and short decimals.
+    unsigned long long bits = 88172645463325252ULL;
+    for (int i = 0; i < 2000; ++i) {
+        bits ^= bits << 13;
+        bits ^= bits >> 7;
+        bits ^= bits << 17;
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        float f;
+        const unsigned u = static_cast<unsigned>(bits);
+        memcpy(&f, &u, sizeof(f));
+        if (!isnan(d) && !isinf(d)) {
+            EXPECT_TRUE(checkFloat(d));
+        }
+        if (!isnan(f) && !isinf(f)) {
+            EXPECT_TRUE(checkFloat(f));
+        }
+        EXPECT_TRUE(checkFloat(static_cast<double>(bits % 1000000) / 1000));
+        EXPECT_TRUE(checkFloat(static_cast<float>(bits % 100000) / 8));
+    }
     return true;
 }
+
+bool testFloatFlags() {
+    stringstream ss;
+
+    ss << 0.1 << ' ' << 1e100 << ' ' << 1234567.0 << ' ' << -0.0;
+    EXPECT_TRUE(ss.str() == "0.1 1e+100 1.23457e+06 -0");
+
+    ss.str("");
+    ss << INFINITY << ' ' << -INFINITY << ' ' << NAN << ' ';
+    ss.setf(ios_base::uppercase | ios_base::showpos);
+    ss << INFINITY << ' ' << 1e-10f;
+    EXPECT_TRUE(ss.str() == "inf -inf nan +INF +1E-10");
+
+    ss.str("");
+    ss.flags(ios_base::fixed);
+    ss.precision(2);
+    ss << std::setw(8) << -3.14159 << '|';
+    ss.setf(ios_base::left, ios_base::adjustfield);
+    ss << std::setfill('*') << std::setw(8) << 2.5 << '|';
+    ss.setf(ios_base::internal, ios_base::adjustfield);
+    ss << std::setw(8) << -0.005 << '|' << 1e6;
+    EXPECT_TRUE(ss.str() == "   -3.14|2.50****|-***0.01|1000000.00");
+    return true;
+}
+
+// Every float printed with 9 significant digits reads back as itself.
+// Checks one float out of 4093 unless gExhaustive is set.
+bool testFloatRoundTrip() {
+    const unsigned long long step = gExhaustive ? 1 : 4093;
+    stringstream ss;
+    ss.precision(9);
+    for (unsigned long long bits = 0; bits < 0x100000000ULL; bits += step) {
+        const unsigned u = static_cast<unsigned>(bits);
+        float val;
+        memcpy(&val, &u, sizeof(val));
+        if (isnan(val)) {
+            continue;
+        }
+        ss.str("");
+        ss << val;
+        const float back = strtof(ss.str().c_str(), NULL);
+        if (memcmp(&back, &val, sizeof(val)) != 0) {
+            fprintf(stderr, "%a: %s\n", static_cast<double>(val),
+                    ss.str().c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
 }  // namespace android
 
 int main(int argc, char **argv){
@@ -113,6 +383,13 @@ int main(int argc, char **argv){
     FAIL_UNLESS(testInAvail);
     FAIL_UNLESS(testNulChar);
     FAIL_UNLESS(testPut);
+    FAIL_UNLESS(testPutOverflow);
     FAIL_UNLESS(testStringStream);
+    FAIL_UNLESS(testIntegers);
+    FAIL_UNLESS(testIntegerFlags);
+    FAIL_UNLESS(testFloats);
+    FAIL_UNLESS(testFloatFlags);
+    android::gExhaustive = argc > 1 && strcmp(argv[1], "--exhaustive") == 0;
+    FAIL_UNLESS(testFloatRoundTrip);
     return kPassed;
 }
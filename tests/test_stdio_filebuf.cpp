@@ -0,0 +1,115 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "../include/stdio_filebuf.h"
+#ifndef ANDROID_ASTL_STDIO_FILEBUF__
+#error "Wrong header included!!"
+#endif
+#include "common.h"
+#include <cstdio>
+#include <ostream>
+#include <string>
+
+namespace android {
+
+// @return The content of file, the position is left at the end.
+std::string content(FILE *file) {
+    fflush(file);
+    rewind(file);
+    std::string result;
+    char buf[1024];
+    size_t len;
+    while ((len = fread(buf, 1, sizeof(buf), file)) > 0) {
+        result.append(buf, len);
+    }
+    return result;
+}
+
+bool testBuffered() {
+    FILE *file = tmpfile();
+    stdio_filebuf buf(file);
+    std::ostream os(&buf);
+
+    os << "hello " << 42;
+    EXPECT_TRUE(content(file).empty());  // Still in the put area.
+    os << std::flush;
+    EXPECT_TRUE(content(file) == "hello 42");
+
+    os << '!' << std::endl;
+    EXPECT_TRUE(content(file) == "hello 42!\n");
+    fclose(file);
+    return true;
+}
+
+bool testOverflow() {
+    FILE *file = tmpfile();
+    std::string expected;
+    {
+        stdio_filebuf buf(file);
+        std::ostream os(&buf);
+
+        // Small writes filling the buffer several times.
+        for (int i = 0; i < 3000; ++i) {
+            os << "token ";
+            expected += "token ";
+        }
+        // Larger than the buffer: written directly, after the put area.
+        const std::string large(3 * stdio_filebuf::kBufferSize, 'x');
+        os << large;
+        expected += large;
+        os << "end";
+        expected += "end";
+        EXPECT_TRUE(content(file).size() < expected.size());
+    }
+    // Flushed by the destructor.
+    EXPECT_TRUE(content(file) == expected);
+    fclose(file);
+    return true;
+}
+
+bool testUnbuffered() {
+    FILE *file = tmpfile();
+    stdio_filebuf buf(file, false);
+    std::ostream os(&buf);
+
+    os << "abc" << 'd';
+    EXPECT_TRUE(content(file) == "abcd");
+    EXPECT_TRUE(buf.pubsync() == 0);
+    fclose(file);
+    return true;
+}
+
+}  // namespace android
+
+int main(int argc, char **argv){
+    FAIL_UNLESS(testBuffered);
+    FAIL_UNLESS(testOverflow);
+    FAIL_UNLESS(testUnbuffered);
+    return kPassed;
+}
@@ -56,11 +56,8 @@ bool testSputc() {
     EXPECT_TRUE(buf.sputc('C') == 67);
     EXPECT_TRUE(buf.sputc('D') == 68);
     EXPECT_TRUE(buf.sputc('E') == 69);
-    // TODO: The sputc implementation has been changed to use
-    // sputn. This is non standard so disabling the tests below for
-    // now.
-    //    EXPECT_TRUE(buf.sputc('F') == char_traits<char>::eof());
-    //    EXPECT_TRUE(buf.sputc('G') == char_traits<char>::eof());
+    EXPECT_TRUE(buf.sputc('F') == char_traits<char>::eof());
+    EXPECT_TRUE(buf.sputc('G') == char_traits<char>::eof());
     return true;
 }
 
@@ -1101,6 +1101,159 @@ bool testInsert() {
     return true;
 }
 
+// @return The number of steps of a geometric growth from 1 to 10000
+// with the configured factor.
+size_t growthSteps() {
+    size_t steps = 0;
+    for (double c = 1; c < 10000; ++steps) {
+        c = c * ASTL_STRING_GROWTH_NUMERATOR / ASTL_STRING_GROWTH_DENOMINATOR;
+    }
+    return steps;
+}
+
+bool testAppendGrowth() {
+    // 20 with the default factor of 2.
+    const size_t kMaxReallocs = growthSteps() + 6;
+    {
+        // The capacity grows geometrically: few reallocations.
+        string str01;
+        size_t reallocs = 0;
+        for (size_t i = 0; i < 10000; ++i) {
+            const size_t capacity = str01.capacity();
+            str01.push_back('x');
+            if (capacity != str01.capacity()) {
+                ++reallocs;
+            }
+        }
+        EXPECT_TRUE(str01.size() == 10000);
+        EXPECT_TRUE(str01.capacity() >= 10000);
+        EXPECT_TRUE(reallocs < kMaxReallocs);
+
+        str01.reserve();  // shrink to fit.
+        EXPECT_TRUE(str01.capacity() == 10000);
+        EXPECT_TRUE(str01[10000] == '\0');
+    }
+    {
+        string str01;
+        size_t reallocs = 0;
+        for (size_t i = 0; i < 10000; ++i) {
+            const size_t capacity = str01.capacity();
+            str01 += "abc";
+            if (capacity != str01.capacity()) {
+                ++reallocs;
+            }
+        }
+        EXPECT_TRUE(str01.size() == 30000);
+        EXPECT_TRUE(reallocs < kMaxReallocs);
+        EXPECT_TRUE(str01.find("cab") == 2);
+    }
+    {
+        // A large append gets exactly the capacity needed.
+        string str01("abc");
+        str01.append(string(1000, 'x'));
+        EXPECT_TRUE(str01.capacity() == 1003);
+    }
+    return true;
+}
+
+// @return true if the characters of str are stored in the instance.
+bool isInline(const string& str) {
+    const char *begin = reinterpret_cast<const char *>(&str);
+    return str.c_str() >= begin && str.c_str() < begin + sizeof(str);
+}
+
+bool testSmallStringOptimization() {
+    // The inline buffer overlays the heap pointer, length and capacity.
+    EXPECT_TRUE(sizeof(string) == 3 * sizeof(void *));
+    {
+        // Up to sizeof(string) - 2 chars fit in the instance: 10 or 22.
+        const size_t inline_capacity = sizeof(string) - 2;
+        string str01(inline_capacity, 'x');
+        EXPECT_TRUE(isInline(str01));
+        EXPECT_TRUE(str01.capacity() == inline_capacity);
+        EXPECT_TRUE(str01.size() == inline_capacity);
+        EXPECT_TRUE(str01.c_str()[inline_capacity] == '\0');
+
+        string str02(inline_capacity + 1, 'x');
+        EXPECT_TRUE(!isInline(str02));
+
+        string str03(str01);
+        EXPECT_TRUE(isInline(str03));
+        EXPECT_TRUE(str03 == str01);
+
+        str03.erase(3);
+        EXPECT_TRUE(str03 == "xxx");
+        EXPECT_TRUE(str03.capacity() == inline_capacity);
+        str03.reserve();
+        EXPECT_TRUE(str03.capacity() == 3);
+        str03.append(string(inline_capacity - 3, 'y'));
+        EXPECT_TRUE(isInline(str03));
+        EXPECT_TRUE(str03.size() == inline_capacity);
+        str03.push_back('z');
+        EXPECT_TRUE(!isInline(str03));
+        EXPECT_TRUE(str03.size() == inline_capacity + 1);
+        EXPECT_TRUE(str03[inline_capacity] == 'z');
+        EXPECT_TRUE(str03.find_first_of('y') == 3);
+    }
+    {
+        // Reserve moves the data between the instance and the heap.
+        string str01("short");
+        str01.reserve(10);
+        EXPECT_TRUE(isInline(str01));
+        EXPECT_TRUE(str01.capacity() == 10);
+
+        str01.reserve(100);
+        EXPECT_TRUE(!isInline(str01));
+        EXPECT_TRUE(str01 == "short");
+        EXPECT_TRUE(str01.capacity() == 100);
+
+        str01.reserve();  // shrink to fit.
+        EXPECT_TRUE(isInline(str01));
+        EXPECT_TRUE(str01 == "short");
+        EXPECT_TRUE(str01.capacity() == 5);
+
+        str01.append(" and now a long one");
+        EXPECT_TRUE(!isInline(str01));
+        EXPECT_TRUE(str01 == "short and now a long one");
+
+        str01.clear();
+        EXPECT_TRUE(str01.c_str() == string().c_str());
+        EXPECT_TRUE(str01.capacity() == 0);
+    }
+    {
+        // Swap inline and heap strings.
+        string str01("short");
+        string str02("a much longer string than the inline buffer");
+        str01.swap(str02);
+        EXPECT_TRUE(str01 == "a much longer string than the inline buffer");
+        EXPECT_TRUE(!isInline(str01));
+        EXPECT_TRUE(str02 == "short");
+        EXPECT_TRUE(isInline(str02));
+
+        string str03("tiny");
+        str02.swap(str03);
+        EXPECT_TRUE(str02 == "tiny");
+        EXPECT_TRUE(str03 == "short");
+        EXPECT_TRUE(isInline(str02));
+        EXPECT_TRUE(isInline(str03));
+    }
+    {
+        // No allocation for short strings.
+        const size_t allocated = heapAllocatedBytes();
+        string strs[100];
+        for (size_t i = 0; i < ARRAYSIZE(strs); ++i) {
+            strs[i] = "k ";
+            strs[i] += static_cast<char>('0' + i % 10);
+            strs[i].push_back('!');
+            strs[i].insert(strs[i].begin(), '#');
+        }
+        string str01(strs[0] + strs[1]);
+        EXPECT_TRUE(str01 == "#k 0!#k 1!");
+        EXPECT_TRUE(heapAllocatedBytes() == allocated);
+    }
+    return true;
+}
+
 }  // namespace android
 
 int main(int argc, char **argv)
@@ -1131,5 +1284,7 @@ int main(int argc, char **argv)
     FAIL_UNLESS(testSubstr);
     FAIL_UNLESS(testCharSearch);
     FAIL_UNLESS(testInsert);
+    FAIL_UNLESS(testSmallStringOptimization);
+    FAIL_UNLESS(testAppendGrowth);
     return kPassed;
 }
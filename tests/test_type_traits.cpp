@@ -119,6 +119,19 @@ bool testIsPodOrClass()
     EXPECT_TRUE(is_class<A>::value == true);
     return true;
 }
+
+class Relocatable {};
+template<>
+struct is_trivially_relocatable<Relocatable>: public std::true_type { };
+
+bool testIsTriviallyRelocatable()
+{
+    EXPECT_TRUE(is_trivially_relocatable<int>::value == true);
+    EXPECT_TRUE(is_trivially_relocatable<int *>::value == true);
+    EXPECT_TRUE(is_trivially_relocatable<A>::value == false);
+    EXPECT_TRUE(is_trivially_relocatable<Relocatable>::value == true);
+    return true;
+}
 }  // namespace android
 
 int main(int argc, char **argv)
@@ -128,5 +141,6 @@ int main(int argc, char **argv)
     FAIL_UNLESS(testIsFloatingPoint);
     FAIL_UNLESS(testIsPointer);
     FAIL_UNLESS(testIsPodOrClass);
+    FAIL_UNLESS(testIsTriviallyRelocatable);
     return kPassed;
 }
@@ -0,0 +1,242 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "../include/unordered_map"
+#ifndef ANDROID_ASTL_UNORDERED_MAP__
+#error "Wrong header included!!"
+#endif
+#include <string>
+#include "common.h"
+
+namespace android {
+using std::pair;
+using std::string;
+using std::unordered_map;
+
+bool testConstructor()
+{
+    unordered_map<int, int> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_TRUE(m.size() == 0);
+    EXPECT_TRUE(m.begin() == m.end());
+    EXPECT_TRUE(m.find(10) == m.end());
+    return true;
+}
+
+bool testInsert()
+{
+    unordered_map<int, string> m;
+    pair<unordered_map<int, string>::iterator, bool> res;
+
+    res = m.insert(std::make_pair(10, string("ten")));
+    EXPECT_TRUE(res.second);
+    EXPECT_TRUE(res.first == m.begin());
+    EXPECT_TRUE(res.first->first == 10);
+    EXPECT_TRUE(res.first->second == "ten");
+
+    // Same key: no insertion, the iterator points to the original.
+    res = m.insert(std::make_pair(10, string("dix")));
+    EXPECT_TRUE(!res.second);
+    EXPECT_TRUE(res.first->second == "ten");
+
+    m.insert(std::make_pair(5, string("five")));
+    m.insert(std::make_pair(20, string("twenty")));
+    EXPECT_TRUE(m.size() == 3);
+    EXPECT_TRUE(m.find(5)->second == "five");
+    EXPECT_TRUE(m.find(20)->second == "twenty");
+
+    res.first->second = "TEN";
+    EXPECT_TRUE(m.find(10)->second == "TEN");
+    return true;
+}
+
+bool testSubscript()
+{
+    unordered_map<string, int> m;
+
+    m["one"] = 1;
+    m["two"] = 2;
+    EXPECT_TRUE(m.size() == 2);
+    EXPECT_TRUE(m["one"] == 1);
+    EXPECT_TRUE(m["two"] == 2);
+
+    // Missing key: inserts a default value.
+    EXPECT_TRUE(m["three"] == 0);
+    EXPECT_TRUE(m.size() == 3);
+
+    ++m["one"];
+    EXPECT_TRUE(m.find("one")->second == 2);
+    return true;
+}
+
+// Every key lands in the same bucket: the probe distances go past
+// what a control byte holds.
+struct ConstHash {
+    size_t operator()(int) const { return 7; }
+};
+
+bool testConstantHash()
+{
+    unordered_map<int, int, ConstHash> m;
+    const int n = 600;
+    for (int i = 0; i < n; ++i) {
+        m[i] = i * 2;
+    }
+    EXPECT_TRUE(m.size() == static_cast<size_t>(n));
+    EXPECT_TRUE(m.bucket_count() <= 1024);
+    for (int i = 0; i < n; ++i) {
+        EXPECT_TRUE(m.find(i) != m.end());
+        EXPECT_TRUE(m[i] == i * 2);
+    }
+    EXPECT_TRUE(m.find(n) == m.end());
+    for (int i = 0; i < n; i += 2) {
+        EXPECT_TRUE(m.erase(i) == 1);
+    }
+    EXPECT_TRUE(m.size() == static_cast<size_t>(n / 2));
+    for (int i = 0; i < n; ++i) {
+        EXPECT_TRUE(m.count(i) == (i % 2 == 0 ? 0 : 1));
+    }
+    size_t visited = 0;
+    for (unordered_map<int, int, ConstHash>::iterator it = m.begin(); it != m.end(); ++it) {
+        EXPECT_TRUE(it->second == it->first * 2);
+        ++visited;
+    }
+    EXPECT_TRUE(visited == static_cast<size_t>(n / 2));
+    return true;
+}
+
+bool testFindErase()
+{
+    unordered_map<int, int> m;
+    m.reserve(1000);
+    for (int i = 0; i < 1000; ++i) {
+        m[i] = i * i;
+    }
+    EXPECT_TRUE(m.size() == 1000);
+    EXPECT_TRUE(m.find(30)->second == 900);
+    EXPECT_TRUE(m.count(999) == 1);
+    EXPECT_TRUE(m.count(1000) == 0);
+
+    EXPECT_TRUE(m.erase(30) == 1);
+    EXPECT_TRUE(m.erase(30) == 0);
+    EXPECT_TRUE(m.find(30) == m.end());
+
+    // Erase invalidates the iterators: restart from begin().
+    while (!m.empty() && m.size() > 500) {
+        m.erase(m.begin());
+    }
+    EXPECT_TRUE(m.size() == 500);
+
+    const unordered_map<int, int>& cm = m;
+    int sum = 0;
+    for (unordered_map<int, int>::const_iterator i = cm.begin(); i != cm.end(); ++i) {
+        EXPECT_TRUE(i->second == i->first * i->first);
+        EXPECT_TRUE(cm.find(i->first) == i);
+        ++sum;
+    }
+    EXPECT_TRUE(sum == 500);
+
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    EXPECT_TRUE(m.find(1) == m.end());
+    return true;
+}
+
+// Checks it is copied rather than moved with memcpy: mSelf must point
+// to the instance.
+struct NotRelocatable {
+    NotRelocatable(): mSelf(this) { ++sInstances; }
+    NotRelocatable(const NotRelocatable&): mSelf(this) { ++sInstances; }
+    ~NotRelocatable() { --sInstances; }
+    NotRelocatable& operator=(const NotRelocatable&) { return *this; }
+    bool valid() const { return mSelf == this; }
+    NotRelocatable *mSelf;
+    static int sInstances;
+};
+int NotRelocatable::sInstances = 0;
+
+bool testNotRelocatable()
+{
+    {
+        unordered_map<int, NotRelocatable> m;
+        for (int i = 0; i < 1000; ++i) {
+            m[i];
+        }
+        for (int i = 0; i < 1000; i += 2) {
+            m.erase(i);
+        }
+        EXPECT_TRUE(NotRelocatable::sInstances == 500);
+        for (unordered_map<int, NotRelocatable>::iterator i = m.begin();
+             i != m.end(); ++i) {
+            EXPECT_TRUE(i->second.valid());
+        }
+        unordered_map<int, NotRelocatable> copy(m);
+        EXPECT_TRUE(NotRelocatable::sInstances == 1000);
+        EXPECT_TRUE(copy.find(1)->second.valid());
+    }
+    EXPECT_TRUE(NotRelocatable::sInstances == 0);
+    return true;
+}
+
+bool testCopyAndSwap()
+{
+    unordered_map<int, string> m1;
+    m1[1] = "one";
+    m1[2] = "two";
+
+    unordered_map<int, string> m2(m1);
+    m1[1] = "uno";
+    EXPECT_TRUE(m2.size() == 2);
+    EXPECT_TRUE(m2[1] == "one");
+
+    unordered_map<int, string> m3;
+    m3[3] = "three";
+    m3.swap(m2);
+    EXPECT_TRUE(m3.size() == 2);
+    EXPECT_TRUE(m2.size() == 1);
+    EXPECT_TRUE(m2[3] == "three");
+
+    m3 = m1;
+    EXPECT_TRUE(m3[1] == "uno");
+    return true;
+}
+
+}  // namespace android
+
+int main(int argc, char **argv)
+{
+    FAIL_UNLESS(testConstructor);
+    FAIL_UNLESS(testInsert);
+    FAIL_UNLESS(testSubscript);
+    FAIL_UNLESS(testFindErase);
+    FAIL_UNLESS(testConstantHash);
+    FAIL_UNLESS(testNotRelocatable);
+    FAIL_UNLESS(testCopyAndSwap);
+    return kPassed;
+}
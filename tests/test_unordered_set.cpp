@@ -0,0 +1,329 @@
+/* -*- c++ -*- */
+/*
+ * Copyright (C) 2010 The Android Open Source Project
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS
+ * OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ * AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+ * OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ */
+
+#include "../include/unordered_set"
+#ifndef ANDROID_ASTL_UNORDERED_SET__
+#error "Wrong header included!!"
+#endif
+#include <string>
+#include "common.h"
+
+namespace android {
+using std::pair;
+using std::string;
+using std::unordered_set;
+
+bool testConstructor()
+{
+    unordered_set<int> s;
+    EXPECT_TRUE(s.empty());
+    EXPECT_TRUE(s.size() == 0);
+    EXPECT_TRUE(s.begin() == s.end());
+    EXPECT_TRUE(s.find(10) == s.end());
+    EXPECT_TRUE(s.count(10) == 0);
+    EXPECT_TRUE(s.bucket_count() == 0);
+    EXPECT_TRUE(s.load_factor() == 0.0f);
+
+    // Buckets are powers of 2.
+    unordered_set<int> s2(100);
+    EXPECT_TRUE(s2.bucket_count() == 128);
+    EXPECT_TRUE(s2.empty());
+
+    const int array[] = {3, 1, 4, 1, 5, 9, 2, 6};
+    unordered_set<int> s3(array, array + 8);
+    EXPECT_TRUE(s3.size() == 7);
+    return true;
+}
+
+bool testInsertFindErase()
+{
+    unordered_set<int> s;
+    pair<unordered_set<int>::iterator, bool> res;
+
+    res = s.insert(10);
+    EXPECT_TRUE(res.second);
+    EXPECT_TRUE(*res.first == 10);
+    EXPECT_TRUE(res.first == s.begin());
+
+    res = s.insert(10);
+    EXPECT_TRUE(!res.second);
+    EXPECT_TRUE(*res.first == 10);
+    EXPECT_TRUE(s.size() == 1);
+
+    for (int i = 0; i < 1000; ++i) {
+        s.insert(i);
+    }
+    EXPECT_TRUE(s.size() == 1000);
+    EXPECT_TRUE(s.load_factor() <= s.max_load_factor());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(s.count(i) == 1);
+        EXPECT_TRUE(*s.find(i) == i);
+    }
+    EXPECT_TRUE(s.find(1000) == s.end());
+
+    // Iteration visits every element once.
+    size_t n = 0;
+    int sum = 0;
+    for (unordered_set<int>::iterator i = s.begin(); i != s.end(); ++i, ++n) {
+        sum += *i;
+    }
+    EXPECT_TRUE(n == 1000);
+    EXPECT_TRUE(sum == 999 * 1000 / 2);
+
+    for (int i = 0; i < 1000; i += 2) {
+        EXPECT_TRUE(s.erase(i) == 1);
+    }
+    EXPECT_TRUE(s.erase(0) == 0);
+    EXPECT_TRUE(s.size() == 500);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(s.count(i) == static_cast<size_t>(i % 2));
+    }
+
+    s.erase(s.find(1));
+    EXPECT_TRUE(s.count(1) == 0);
+    EXPECT_TRUE(s.size() == 499);
+
+    const size_t buckets = s.bucket_count();
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_TRUE(s.begin() == s.end());
+    EXPECT_TRUE(s.bucket_count() == buckets);
+    s.rehash(0);
+    EXPECT_TRUE(s.bucket_count() == 0);
+    return true;
+}
+
+bool testHashPolicy()
+{
+    unordered_set<int> s;
+
+    s.reserve(1000);
+    const size_t buckets = s.bucket_count();
+    EXPECT_TRUE(buckets * s.max_load_factor() >= 1000);
+    for (int i = 0; i < 1000; ++i) {
+        s.insert(i);
+    }
+    EXPECT_TRUE(s.bucket_count() == buckets);  // no rehash
+
+    s.rehash(4096);
+    EXPECT_TRUE(s.bucket_count() == 4096);
+    EXPECT_TRUE(s.size() == 1000);
+    EXPECT_TRUE(s.count(999) == 1);
+
+    // Shrink to fit.
+    s.rehash(0);
+    EXPECT_TRUE(s.bucket_count() == 2048);
+    EXPECT_TRUE(s.load_factor() <= s.max_load_factor());
+
+    // Out of range values are ignored.
+    s.max_load_factor(0.0f);
+    s.max_load_factor(1.5f);
+    EXPECT_TRUE(s.max_load_factor() == 0.8f);
+
+    s.max_load_factor(0.25f);
+    EXPECT_TRUE(s.max_load_factor() == 0.25f);
+    EXPECT_TRUE(s.load_factor() <= 0.25f);
+    EXPECT_TRUE(s.bucket_count() == 4096);
+
+    s.max_load_factor(1.0f);
+    s.rehash(0);
+    EXPECT_TRUE(s.bucket_count() == 1024);
+    for (int i = 1000; i < 1024; ++i) {
+        s.insert(i);
+    }
+    EXPECT_TRUE(s.load_factor() == 1.0f);
+    EXPECT_TRUE(s.find(2000) == s.end());
+    for (int i = 0; i < 1024; ++i) {
+        EXPECT_TRUE(s.count(i) == 1);
+    }
+    return true;
+}
+
+// All the keys collide.
+struct BadHash {
+    size_t operator()(int) const { return 42; }
+};
+
+bool testCollisions()
+{
+    unordered_set<int, BadHash> s;
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_TRUE(s.insert(i).second);
+    }
+    EXPECT_TRUE(s.size() == 200);
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_TRUE(s.count(i) == 1);
+    }
+    EXPECT_TRUE(s.count(200) == 0);
+    for (int i = 0; i < 200; i += 3) {
+        EXPECT_TRUE(s.erase(i) == 1);
+    }
+    for (int i = 0; i < 200; ++i) {
+        EXPECT_TRUE(s.count(i) == (i % 3 == 0 ? 0 : 1));
+    }
+
+    // Past 255 the distances do not fit in the control bytes. The
+    // table only grows with the load factor.
+    for (int i = 0; i < 1000; ++i) {
+        s.insert(i);
+    }
+    EXPECT_TRUE(s.size() == 1000);
+    EXPECT_TRUE(s.bucket_count() == 2048);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(s.count(i) == 1);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        EXPECT_TRUE(s.erase(i) == 1);
+    }
+    s.rehash(0);
+    EXPECT_TRUE(s.size() == 500);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_TRUE(s.count(i) == (i % 2 == 0 ? 0 : 1));
+    }
+    return true;
+}
+
+// Undoes the table's Fibonacci hashing so key i lands in bucket
+// i >> 5 of a 4096 bucket table: 256 keys fit in 4096 buckets but
+// all share bucket 0 at 512.
+struct ClusterHash {
+    size_t operator()(int k) const {
+        const size_t golden = sizeof(size_t) == 8 ?
+                static_cast<size_t>(0x9E3779B97F4A7C15ULL) :
+                static_cast<size_t>(0x9E3779B9UL);
+        size_t inverse = golden;
+        for (int i = 0; i < 5; ++i) {  // Newton's iteration mod 2^N
+            inverse *= 2 - golden * inverse;
+        }
+        return (static_cast<size_t>(k) << (sizeof(size_t) * 8 - 17)) * inverse;
+    }
+};
+
+bool testShrinkClustered()
+{
+    unordered_set<int, ClusterHash> s(4096);
+    for (int i = 0; i < 256; ++i) {
+        EXPECT_TRUE(s.insert(i).second);
+    }
+    EXPECT_TRUE(s.bucket_count() == 4096);
+    s.rehash(0);
+    EXPECT_TRUE(s.bucket_count() < 4096);
+    EXPECT_TRUE(s.size() == 256);
+    for (int i = 0; i < 256; ++i) {
+        EXPECT_TRUE(s.count(i) == 1);
+    }
+    return true;
+}
+
+bool testStrings()
+{
+    unordered_set<string> s;
+    s.insert("one");
+    s.insert("two");
+    s.insert(string("one"));
+    EXPECT_TRUE(s.size() == 2);
+    EXPECT_TRUE(s.count("one") == 1);
+    EXPECT_TRUE(s.count("three") == 0);
+
+    char buffer[16];
+    for (int i = 0; i < 500; ++i) {
+        snprintf(buffer, sizeof(buffer), "key-%d", i);
+        s.insert(buffer);
+    }
+    EXPECT_TRUE(s.size() == 502);
+    EXPECT_TRUE(*s.find("key-499") == "key-499");
+    return true;
+}
+
+bool testCopyAndSwap()
+{
+    unordered_set<int> s1;
+    for (int i = 0; i < 100; ++i) {
+        s1.insert(i);
+    }
+    unordered_set<int> s2(s1);
+    EXPECT_TRUE(s2.size() == 100);
+    s1.erase(50);
+    EXPECT_TRUE(s2.count(50) == 1);
+
+    unordered_set<int> s3;
+    s3.insert(1000);
+    s3 = s1;
+    EXPECT_TRUE(s3.size() == 99);
+    EXPECT_TRUE(s3.count(1000) == 0);
+
+    unordered_set<int> s4;
+    s4.insert(-1);
+    std::swap(s1, s4);
+    EXPECT_TRUE(s1.size() == 1);
+    EXPECT_TRUE(s1.count(-1) == 1);
+    EXPECT_TRUE(s4.size() == 99);
+    EXPECT_TRUE(s4.count(0) == 1);
+    return true;
+}
+
+bool testStress()
+{
+    unordered_set<int> s;
+    bool present[10000] = {false};
+    unsigned int seed = 1;
+    size_t count = 0;
+
+    for (int i = 0; i < 100000; ++i) {
+        seed = seed * 1103515245 + 12345;
+        const int value = (seed >> 8) % 10000;
+        if (value % 3 == 0) {
+            count -= s.erase(value);
+            present[value] = false;
+        } else {
+            count += s.insert(value).second ? 1 : 0;
+            present[value] = true;
+        }
+    }
+    EXPECT_TRUE(s.size() == count);
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(s.count(i) == (present[i] ? 1 : 0));
+    }
+    return true;
+}
+
+}  // namespace android
+
+int main(int argc, char **argv)
+{
+    FAIL_UNLESS(testConstructor);
+    FAIL_UNLESS(testInsertFindErase);
+    FAIL_UNLESS(testHashPolicy);
+    FAIL_UNLESS(testCollisions);
+    FAIL_UNLESS(testShrinkClustered);
+    FAIL_UNLESS(testStrings);
+    FAIL_UNLESS(testCopyAndSwap);
+    FAIL_UNLESS(testStress);
+    return kPassed;
+}
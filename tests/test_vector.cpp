@@ -649,6 +649,85 @@ bool testAt() {
     EXPECT_TRUE(vec.at(1000) == 0xdeadbeef);
     return true;
 }
+// Counts the copies, opts in to be relocated with realloc.
+struct RelocatableCounter {
+    static size_t mCopyCount;
+    RelocatableCounter() { }
+    RelocatableCounter(const RelocatableCounter& rc) { ++mCopyCount; }
+};
+size_t RelocatableCounter::mCopyCount;
+
+template<>
+struct is_trivially_relocatable<RelocatableCounter>: public std::true_type { };
+
+bool testReserveRelocatable()
+{
+    EXPECT_TRUE(is_trivially_relocatable<string>::value);
+    EXPECT_TRUE(is_trivially_relocatable<vector<string> >::value);
+    {
+        RelocatableCounter c;
+        vector<RelocatableCounter> vec1(10, c);
+
+        RelocatableCounter::mCopyCount = 0;
+        vec1.reserve(1000);
+        EXPECT_TRUE(vec1.capacity() == 1000);
+        EXPECT_TRUE(RelocatableCounter::mCopyCount == 0);
+        vec1.reserve();
+        EXPECT_TRUE(vec1.capacity() == 10);
+        EXPECT_TRUE(RelocatableCounter::mCopyCount == 0);
+    }
+    {
+        // Short and long strings survive the relocation.
+        vector<string> vec2;
+        for (int i = 0; i < 1000; ++i)
+        {
+            vec2.push_back(i % 2 ? "short" : "a string too long to be inline");
+        }
+        for (int i = 0; i < 1000; ++i)
+        {
+            EXPECT_TRUE(vec2[i] == (i % 2 ? "short" : "a string too long to be inline"));
+        }
+        vec2.reserve();
+        EXPECT_TRUE(vec2[999] == "short");
+    }
+    return true;
+}
+
+bool testPushBackGrowth()
+{
+    {
+        // The capacity grows geometrically: few reallocations.
+        vector<int> vec1;
+        size_t reallocs = 0;
+        for (int i = 0; i < 100000; ++i)
+        {
+            const size_t capacity = vec1.capacity();
+            vec1.push_back(i);
+            if (capacity != vec1.capacity())
+            {
+                ++reallocs;
+            }
+        }
+        EXPECT_TRUE(vec1.size() == 100000);
+        EXPECT_TRUE(reallocs < 25);
+        EXPECT_TRUE(vec1[99999] == 99999);
+    }
+    {
+        CtorDtorCounter c;
+        vector<CtorDtorCounter> vec2;
+
+        c.reset();
+        for (int i = 0; i < 10000; ++i)
+        {
+            vec2.push_back(c);
+        }
+        // Each element is copied on average less than twice when the
+        // capacity grows.
+        EXPECT_TRUE(c.mCopyCtorCount < 10000 + 2 * 10000);
+    }
+    return true;
+}
+
 }  // namespace android
 
 int main(int argc, char **argv)
@@ -659,7 +738,9 @@ int main(int argc, char **argv)
     FAIL_UNLESS(testConstructorRepeat);
     FAIL_UNLESS(testConstructorIterator);
     FAIL_UNLESS(testReserve);
+    FAIL_UNLESS(testReserveRelocatable);
     FAIL_UNLESS(testPushBack);
+    FAIL_UNLESS(testPushBackGrowth);
     FAIL_UNLESS(testPopBack);
     FAIL_UNLESS(testResize);
     FAIL_UNLESS(testSwap);